@@ -0,0 +1,102 @@
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <string>
+#include "Models/Sequential.h"
+#include "Metrics/LossFunctions.h"
+#include "Data/Dataset.h"
+#include "Utils/ThreadPool.h"
+
+using namespace std;
+
+// Convergence / throughput comparison of the synchronous train() loop
+// (serial and data-parallel) against asynchronous Hogwild training on a
+// sparse, wide classification problem.
+//
+// Usage: make run FILE=Examples/hogwild_benchmark.cpp
+
+namespace {
+
+const size_t kFeatures = 2000;     // wide input
+const size_t kActive = 20;         // non-zero features per sample (1%)
+const size_t kClasses = 10;
+const size_t kHidden = 64;
+const size_t kEpochs = 3;
+const size_t kBatchSize = 32;
+
+// Bag-of-words style samples: each class owns a block of features; a sample
+// activates a few features of its class block plus random noise features.
+void makeData(size_t rows, unsigned seed, Dataset& X, Dataset& y) {
+    mt19937 rng(seed);
+    const size_t block = kFeatures / kClasses;
+    uniform_int_distribution<size_t> label(0, kClasses - 1);
+    uniform_int_distribution<size_t> in_block(0, block - 1);
+    uniform_int_distribution<size_t> any_feature(0, kFeatures - 1);
+    uniform_real_distribution<double> value(0.5, 1.5);
+
+    vector<vector<Scalar>> x_rows(rows, vector<Scalar>(kFeatures, 0.0));
+    vector<vector<Scalar>> y_rows(rows, vector<Scalar>(kClasses, 0.0));
+    for (size_t i = 0; i < rows; ++i) {
+        const size_t c = label(rng);
+        for (size_t k = 0; k < kActive / 4; ++k) x_rows[i][c * block + in_block(rng)] = static_cast<Scalar>(value(rng));
+        for (size_t k = kActive / 4; k < kActive; ++k) x_rows[i][any_feature(rng)] = static_cast<Scalar>(value(rng));
+        y_rows[i][c] = 1.0;
+    }
+    X = Dataset(std::move(x_rows));
+    y = Dataset(std::move(y_rows));
+}
+
+Sequential makeModel() {
+    Sequential model(
+        std::make_unique<DenseLayer>(kFeatures, kHidden),
+        std::make_unique<ActivationLayer>(ActivationType::RELU),
+        std::make_unique<DenseLayer>(kHidden, kClasses)
+    );
+    model.initializeParameters(21);
+    return model;
+}
+
+enum class Mode { SERIAL, DATA_PARALLEL, HOGWILD };
+
+void run(Mode mode, const string& name, const Dataset& X_train, const Dataset& y_train,
+         const Dataset& X_test, const Dataset& y_test) {
+    Sequential model = makeModel();
+    SGD optimizer(0.02, 0.9, kBatchSize);
+    if (mode == Mode::DATA_PARALLEL) model.setDataParallel();
+
+    cout << "\n== " << name << " ==\n";
+    double total_seconds = 0.0;
+    for (size_t epoch = 0; epoch < kEpochs; ++epoch) {
+        auto start = chrono::steady_clock::now();
+        double loss = mode == Mode::HOGWILD
+            ? model.trainAsync(X_train, y_train, optimizer, Losses::CrossEntropyLoss(true), 0, 21 + epoch)
+            : model.train(X_train, y_train, optimizer, Losses::CrossEntropyLoss(true), 21 + epoch);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        total_seconds += seconds;
+
+        cout << "Epoch " << (epoch + 1) << "/" << kEpochs
+             << " | Loss: " << fixed << setprecision(4) << loss
+             << " | Test acc: " << setprecision(2) << 100.0 * model.evaluate(X_test, y_test, Losses::CrossEntropyLoss(true)).accuracy << "%"
+             << " | " << setprecision(3) << seconds << " s"
+             << " (" << setprecision(0) << X_train.rows() / seconds << " samples/s)\n";
+    }
+    cout << "Total: " << setprecision(3) << total_seconds << " s\n";
+}
+
+} // namespace
+
+int main() {
+    Dataset X_train, y_train, X_test, y_test;
+    makeData(8000, 1, X_train, y_train);
+    makeData(2000, 2, X_test, y_test);
+
+    cout << "Sparse wide benchmark: " << X_train.rows() << " samples, " << kFeatures
+         << " features (" << kActive << " active), batch " << kBatchSize
+         << ", threads " << ThreadPool::global().size() << "\n";
+
+    run(Mode::SERIAL, "Synchronous train (serial)", X_train, y_train, X_test, y_test);
+    run(Mode::DATA_PARALLEL, "Synchronous train (data-parallel)", X_train, y_train, X_test, y_test);
+    run(Mode::HOGWILD, "Asynchronous trainAsync (Hogwild)", X_train, y_train, X_test, y_test);
+    return 0;
+}
@@ -1,10 +1,14 @@
 #include <iostream>
 #include "Models/Sequential.h"
 #include "Metrics/Losses.h"
+#include "Metrics/LossFunctions.h"
 #include "Data/Dataset.h"
 #include "Data/Preprocessing.h"
 #include "Utils/Activations.h"
 #include "Utils/Scheduler.h"
+#include "Models/QuantizedSequential.h"
+#include "Models/StaticSequential.h"
+#include <chrono>
 
 using namespace std;
 
@@ -85,30 +89,22 @@ int main() {
             X_train, 
             y_train,
             optimizer,
-            // [](const vector<double>& y_true, const vector<double>& y_pred) {
+            // [](const vector<Scalar>& y_true, const vector<Scalar>& y_pred) {
             //     return Losses::cross_entropy_loss(y_true, y_pred, true);
             // },
-            // [](const vector<double>& y_true, const vector<double>& y_pred) {
+            // [](const vector<Scalar>& y_true, const vector<Scalar>& y_pred) {
             //     return Losses::cross_entropy_derivative(y_true, y_pred, true);
-            [](const vector<vector<double>>& y_true, const vector<vector<double>>& y_pred) {
+            [](const vector<vector<Scalar>>& y_true, const vector<vector<Scalar>>& y_pred) {
                 return Losses::cross_entropy_loss_batch(y_true, y_pred, true);
             },
-            [](const vector<vector<double>>& y_true, const vector<vector<double>>& y_pred) {
+            [](const vector<vector<Scalar>>& y_true, const vector<vector<Scalar>>& y_pred) {
                 return Losses::cross_entropy_derivative_batch(y_true, y_pred, true);
             },
             21
         );
         
         // Test evaluation
-        size_t correct = 0;
-        for (size_t i = 0; i < X_test.rows(); ++i) {
-            vector<double> output = model.forward(X_test[i]);
-            output = Activations::softmax(output);
-            size_t pred_class = distance(output.begin(), max_element(output.begin(), output.end()));
-            size_t true_class = distance(y_test[i].begin(), max_element(y_test[i].begin(), y_test[i].end()));
-            if (pred_class == true_class) correct++;
-        }
-        double accuracy = static_cast<double>(correct) / X_test.rows() * 100;
+        double accuracy = model.evaluate(X_test, y_test, Losses::CrossEntropyLoss(true)).accuracy * 100;
         
         // Print every 10 epochs
         if (epoch % 10 == 0 || epoch == epochs-1 || epoch < 10) {
@@ -119,5 +115,58 @@ int main() {
         }
     }
 
+    // Post-training INT8 quantization (calibrated on the training features)
+    QuantizedSequential qmodel(model, X_train);
+    qmodel.summary();
+    size_t q_correct = 0;
+    for (size_t i = 0; i < X_test.rows(); ++i) {
+        vector<Scalar> output = qmodel.forward(X_test[i]);
+        size_t pred_class = distance(output.begin(), max_element(output.begin(), output.end()));
+        size_t true_class = distance(y_test[i].begin(), max_element(y_test[i].begin(), y_test[i].end()));
+        if (pred_class == true_class) q_correct++;
+    }
+    std::cout << "INT8 Acc: " << static_cast<double>(q_correct) / X_test.rows() * 100 << "%\n";
+
+    // Same architecture with compile-time shapes: no virtual calls, stack activations
+    StaticSequential<
+        StaticDenseLayer<4, 4>, StaticActivationLayer<4, ActivationType::LEAKY_RELU>,
+        StaticDenseLayer<4, 4>, StaticActivationLayer<4, ActivationType::LEAKY_RELU>,
+        StaticDenseLayer<4, 3>
+    > static_model;
+    static_model.initializeParameters(21);
+    static_model.summary();
+    SGD static_optimizer(base_lr, 0.9, base_batch_size, Schedulers::cosine_warmup(1e-4, total_steps, total_steps/4));
+    static_optimizer.setGradientClip(0.1);
+    for (size_t epoch = 0; epoch < epochs; ++epoch) {
+        static_model.train(X_train, y_train, static_optimizer, Losses::CrossEntropyLoss(true), 21);
+    }
+    std::cout << "Static Acc: "
+              << static_model.evaluate(X_test, y_test, Losses::CrossEntropyLoss(true)).accuracy * 100 << "%\n";
+
+    // Per-sample inference latency, dynamic vs static
+    const size_t repeats = 2000;
+    vector<Scalar> output(y_test.cols()), scratch;
+    Scalar checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; ++r) {
+        for (size_t i = 0; i < X_test.rows(); ++i) {
+            model.predictInto(X_test[i].data(), X_test.cols(), output.data(), scratch);
+            checksum += output[0];
+        }
+    }
+    auto middle = chrono::steady_clock::now();
+    for (size_t r = 0; r < repeats; ++r) {
+        for (size_t i = 0; i < X_test.rows(); ++i) {
+            static_model.predictInto(X_test[i].data(), output.data());
+            checksum += output[0];
+        }
+    }
+    auto end = chrono::steady_clock::now();
+    const double samples = static_cast<double>(repeats * X_test.rows());
+    std::cout << "Predict latency: Sequential "
+              << chrono::duration<double, nano>(middle - start).count() / samples << " ns | StaticSequential "
+              << chrono::duration<double, nano>(end - middle).count() / samples << " ns (checksum "
+              << checksum << ")\n";
+
     return 0; 
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <iostream>
 #include "Models/Sequential.h"
 #include "Metrics/Losses.h"
+#include "Metrics/LossFunctions.h"
 #include "Data/Dataset.h"
 #include "Data/Preprocessing.h"
 #include "Utils/Activations.h"
@@ -90,36 +91,31 @@ int main() {
             X_train, 
             y_train,
             optimizer,
-            // [](const vector<double>& y_true, const vector<double>& y_pred) {
+            // [](const vector<Scalar>& y_true, const vector<Scalar>& y_pred) {
             //     return Losses::cross_entropy_loss(y_true, y_pred, true);
             // },
-            // [](const vector<double>& y_true, const vector<double>& y_pred) {
+            // [](const vector<Scalar>& y_true, const vector<Scalar>& y_pred) {
             //     return Losses::cross_entropy_derivative(y_true, y_pred, true);
-            [](const vector<vector<double>>& y_true, const vector<vector<double>>& y_pred) {
-                return Losses::cross_entropy_loss_batch(y_true, y_pred, true);
-            },
-            [](const vector<vector<double>>& y_true, const vector<vector<double>>& y_pred) {
-                return Losses::cross_entropy_derivative_batch(y_true, y_pred, true);
-            },
+            // [](const vector<vector<Scalar>>& y_true, const vector<vector<Scalar>>& y_pred) {
+            //     return Losses::cross_entropy_loss_batch(y_true, y_pred, true);
+            // },
+            // [](const vector<vector<Scalar>>& y_true, const vector<vector<Scalar>>& y_pred) {
+            //     return Losses::cross_entropy_derivative_batch(y_true, y_pred, true);
+            // },
+            Losses::CrossEntropyLoss(true),   // fused softmax + cross entropy on logits
             21
         );
         
-        // Test evaluation
-        size_t correct = 0;
-        for (size_t i = 0; i < X_test.rows(); ++i) {
-            vector<double> output = model.forward(X_test[i]);
-            output = Activations::softmax(output);
-            size_t pred_class = distance(output.begin(), max_element(output.begin(), output.end()));
-            size_t true_class = distance(y_test[i].begin(), max_element(y_test[i].begin(), y_test[i].end()));
-            if (pred_class == true_class) correct++;
-        }
-        double accuracy = static_cast<double>(correct) / X_test.rows() * 100;
+        // Test evaluation: batched, multi-threaded inference over the whole test set
+        Sequential::Evaluation test = model.evaluate(X_test, y_test, Losses::CrossEntropyLoss(true));
+        double accuracy = test.accuracy * 100;
         
         // Print every 10 epochs
         if (epoch % 10 == 0 || epoch == epochs-1 || epoch < 10) {
             std::cout << "Epoch " << (epoch + 1) << "/" << epochs
                       << " | LR: " << optimizer.getLearningRate()
                       << " | Loss: " << epoch_loss
+                      << " | Test loss: " << test.loss
                       << " | Acc: " << accuracy << "%\n";
         }
     }
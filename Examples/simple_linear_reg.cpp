@@ -64,15 +64,15 @@
                 X_train, 
                 y_train,
                 optimizer,
-                // [](const vector<double>& y_true, const vector<double>& y_pred) {
+                // [](const vector<Scalar>& y_true, const vector<Scalar>& y_pred) {
                 //     return Losses::cross_entropy_loss(y_true, y_pred, true);
                 // },
-                // [](const vector<double>& y_true, const vector<double>& y_pred) {
+                // [](const vector<Scalar>& y_true, const vector<Scalar>& y_pred) {
                 //     return Losses::cross_entropy_derivative(y_true, y_pred, true);
-                [](const vector<vector<double>>& y_true, const vector<vector<double>>& y_pred) {
+                [](const vector<vector<Scalar>>& y_true, const vector<vector<Scalar>>& y_pred) {
                     return Losses::mse_loss_batch(y_true, y_pred);
                 },
-                [](const vector<vector<double>>& y_true, const vector<vector<double>>& y_pred) {
+                [](const vector<vector<Scalar>>& y_true, const vector<vector<Scalar>>& y_pred) {
                     return Losses::mse_derivative_batch(y_true, y_pred);
                 },
                 21
@@ -82,7 +82,7 @@
             size_t correct = 0;
             double test_loss = 0;
             for (size_t i = 0; i < X_test.rows(); ++i) {
-                vector<double> output = model.forward(X_test[i]);
+                vector<Scalar> output = model.predict(X_test[i]);
                 test_loss += Losses::mse_loss(y_test[i], output);
             }
             
@@ -96,7 +96,7 @@
         }
         for (size_t i=0; i<X_test.rows(); ++i) {
             std::cout << "Actual : " << y_test[i][0]; 
-            std::cout << "\t\t Predicted : " << model.forward(X_test[i])[0] << std::endl;
+            std::cout << "\t\t Predicted : " << model.predict(X_test[i])[0] << std::endl;
         }
 
 
@@ -105,4 +105,20 @@ public:
      * @return Iterator positioned after last batch
      */
     Iterator end();
+
+    /**
+     * @brief Get the current epoch's row order
+     * @return Row indices; batch b is [b * batch_size, (b + 1) * batch_size)
+     *
+     * Lets several threads claim batches of the same epoch concurrently
+     * (e.g. through an atomic batch counter) without sharing an iterator.
+     * The order is drawn once, by the constructor, and is fixed for the
+     * loader's lifetime (training calls build a new loader per epoch).
+     */
+    const std::vector<size_t>& getOrder() const;
+
+    /**
+     * @brief Get number of batches per epoch (last one may be partial)
+     */
+    size_t numBatches() const;
 };
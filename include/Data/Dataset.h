@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include <cmath>
 #include <utility>
+#include "Utils/Precision.h"
 
 /**
  * @class Dataset
@@ -19,12 +20,12 @@
  */
 class Dataset {
 private:
-    std::vector<std::vector<double>> data; ///< Row-major data storage
+    std::vector<std::vector<Scalar>> data; ///< Row-major data storage (see Utils/Precision.h)
     size_t num_rows = 0;                   ///< Number of rows in dataset
     size_t num_cols = 0;                   ///< Number of columns in dataset
 
     // Helper functions
-    std::vector<double> parseCSVLine(const std::string& line, char delimiter, bool multiple_spaces);
+    std::vector<Scalar> parseCSVLine(const std::string& line, char delimiter, bool multiple_spaces);
     void validateDimensions();
     double computePercentile(const std::vector<double>& sorted_data, double percentile) const;
 
@@ -42,13 +43,13 @@ public:
      * @brief Construct from existing data (copy semantics)
      * @param data 2D vector containing dataset values
      */
-    explicit Dataset(const std::vector<std::vector<double>>& data);
+    explicit Dataset(const std::vector<std::vector<Scalar>>& data);
     
     /**
      * @brief Construct from existing data (move semantics)
      * @param data 2D vector containing dataset values
      */
-    explicit Dataset(std::vector<std::vector<double>>&& data);
+    explicit Dataset(std::vector<std::vector<Scalar>>&& data);
 
     // =================
     // Loading Interface
@@ -182,7 +183,7 @@ public:
      * @brief Convert 2D dataset to 1D vector
      * @return Flattened data in row-major order
      */
-    std::vector<double> flatten() const;
+    std::vector<Scalar> flatten() const;
     
     /**
      * @brief Convert integer labels to one-hot encoding
@@ -203,7 +204,7 @@ public:
      * @brief Get raw data reference
      * @return Const reference to underlying 2D data
      */
-    const std::vector<std::vector<double>>& getData() const;
+    const std::vector<std::vector<Scalar>>& getData() const;
     
     /**
      * @brief Get row count
@@ -226,12 +227,12 @@ public:
      * @param index Row index
      * @return Const reference to row data
      */
-    const std::vector<double>& operator[](size_t index) const;
+    const std::vector<Scalar>& operator[](size_t index) const;
     
     /**
      * @brief Mutable row access
      * @param index Row index
      * @return Mutable reference to row data
      */
-    std::vector<double>& operator[](size_t index);
+    std::vector<Scalar>& operator[](size_t index);
 };
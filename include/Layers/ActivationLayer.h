@@ -9,7 +9,9 @@
 class ActivationLayer : public BaseLayer {
 private:
     ActivationType activation_type; ///< Type of activation function.
-    std::vector<double> input_cache; ///< Cached input for derivative computation.
+    std::vector<Scalar> output_cache; ///< Cached output (derivative is computed from f(x)).
+    std::vector<uint64_t> sign_mask; ///< ReLU / Leaky ReLU: one bit per element instead of output_cache.
+    size_t cache_size = 0; ///< Number of elements seen by the last forward pass.
     double alpha; ///< Parameter for Leaky ReLU and SELU
     double lambda; ///< Parameter for SELU
 
@@ -26,12 +28,13 @@ public:
      * @brief Performs the forward pass of the activation layer.
      * 
      * Applies the activation function element-wise to the input vector.
-     * The input is stored in a cache for use in the backward pass.
+     * Sigmoid, Tanh, SELU and Softmax cache their output; ReLU and Leaky ReLU
+     * cache only a sign bitmask.
      * 
      * @param input A vector containing the input data to the activation layer.
      * @return A vector containing the output of the activation function applied to the input.
      */
-    std::vector<double> forward(const std::vector<double>& input) override;
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) override;
     
     /**
      * @brief Performs the backward pass of the activation layer.
@@ -43,7 +46,41 @@ public:
      * @param lr The learning rate used for gradient descent.
      * @return A vector containing the gradients of the loss with respect to the inputs of this layer.
      */
-    std::vector<double> backward(const std::vector<double>& grad_output) override;
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output) override;
+
+    /**
+     * @brief In-place forward pass; no allocation once the caches have grown.
+     * @param x Input on entry, activated output on exit.
+     */
+    void forwardInPlace(std::vector<Scalar>& x) override;
+
+    /**
+     * @brief In-place backward pass: multiplies the gradient by the cached derivative.
+     * @param grad Gradient w.r.t. the output on entry, w.r.t. the input on exit.
+     */
+    void backwardInPlace(std::vector<Scalar>& grad) override;
+
+    /**
+     * @brief Forward pass into a caller-owned buffer (output may equal input).
+     */
+    void forwardInto(const Scalar* input, size_t input_size, Scalar* output) override;
+
+    /**
+     * @brief Backward pass into a caller-owned buffer (grad_input may equal grad_output).
+     */
+    void backwardInto(const Scalar* grad_output, size_t output_size, Scalar* grad_input) override;
+
+    /**
+     * @brief Applies the activation without recording a cache or sign mask (output may equal input).
+     */
+    void predictInto(const Scalar* input, size_t input_size, Scalar* output) const override;
+
+    /**
+     * @brief Element-wise: the output has the input's width.
+     */
+    size_t outputSize(size_t input_size) const override;
+
+    bool isElementWise() const override { return true; }
     
     /**
      * @brief Prints the details of the activation layer.
@@ -53,10 +90,40 @@ public:
      */
     void summary() const override;
 
+    /**
+     * @brief Creates a copy of the layer with its own caches.
+     */
+    std::unique_ptr<BaseLayer> clone() const override;
+
+    /**
+     * @brief Frees the cached output / sign mask; the next forward pass rebuilds it.
+     */
+    void releaseCache() override;
+
+    /**
+     * @brief Gives the cached output / sign mask to a pool, keeping its capacity.
+     */
+    void recycleCache(CachePool& pool) override;
+
+    /**
+     * @brief Takes a pooled buffer for the output cache or sign mask.
+     */
+    void adoptCache(CachePool& pool) override;
+
     /**
      * @brief Retrieves the type of activation function used in the layer.
      * 
      * @return The activation function type as an enum value of type ActivationType.
      */
     ActivationType getActivationType() const;
+
+    /**
+     * @brief Retrieves the alpha parameter (Leaky ReLU slope / SELU alpha).
+     */
+    double getAlpha() const;
+
+    /**
+     * @brief Retrieves the lambda parameter (SELU scale).
+     */
+    double getLambda() const;
 };
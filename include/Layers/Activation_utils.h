@@ -2,6 +2,12 @@
 
 #include <vector>
 #include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include "../Utils/Precision.h"
+#include "../Utils/FastMath.h"
 
 /**
  * @brief Enumeration for different activation function types.
@@ -29,7 +35,7 @@ enum class ActivationType {
  * @param lambda A parameter used by SELU. Default is 1.0507.
  * @return A vector containing the result of applying the activation function element-wise to the input.
  */
-std::vector<double> applyActivation(const std::vector<double>& x, ActivationType act_type,
+std::vector<Scalar> applyActivation(const std::vector<Scalar>& x, ActivationType act_type,
                                     double alpha = 0.01, double lambda = 1.0507);
 
 /**
@@ -46,9 +52,158 @@ std::vector<double> applyActivation(const std::vector<double>& x, ActivationType
  * @param lambda A parameter used by SELU. Default is 1.0507.
  * @return A vector containing the derivatives of the activation function applied element-wise to the input.
  */
-std::vector<double> activationDerivative(const std::vector<double>& x, ActivationType act_type,
+std::vector<Scalar> activationDerivative(const std::vector<Scalar>& x, ActivationType act_type,
                                          double alpha = 0.01, double lambda = 1.0507);
 
+/**
+ * @brief Applies an element-wise activation to a single value.
+ *
+ * Inline so it can be used in fused layer epilogues. Softmax is not
+ * element-wise and is rejected.
+ *
+ * @param x Input value.
+ * @param act_type Activation type (any except SOFTMAX).
+ * @param alpha Parameter used by Leaky ReLU and SELU.
+ * @param lambda Parameter used by SELU.
+ * @return Activated value.
+ */
+inline Scalar applyActivation(Scalar x, ActivationType act_type, double alpha, double lambda) {
+    switch (act_type) {
+        case ActivationType::RELU:       return x > 0 ? x : Scalar(0);
+        case ActivationType::LEAKY_RELU: return x > 0 ? x : static_cast<Scalar>(alpha * x);
+        case ActivationType::SIGMOID:    return FastMath::sigmoid(x);
+        case ActivationType::TANH:       return FastMath::tanh(x);
+        case ActivationType::LINEAR:     return x;
+        case ActivationType::SELU:
+            return static_cast<Scalar>(lambda * ((x > 0) ? x : alpha * (FastMath::exp(x) - 1)));
+        default:
+            throw std::invalid_argument("applyActivation: activation is not element-wise");
+    }
+}
+
+/**
+ * @brief Computes the derivative of an element-wise activation at a single pre-activation value.
+ *
+ * @param x Pre-activation value.
+ * @param act_type Activation type (any except SOFTMAX).
+ * @param alpha Parameter used by Leaky ReLU and SELU.
+ * @param lambda Parameter used by SELU.
+ * @return Derivative at x.
+ */
+inline Scalar activationDerivative(Scalar x, ActivationType act_type, double alpha, double lambda) {
+    switch (act_type) {
+        case ActivationType::RELU:       return x > 0 ? Scalar(1) : Scalar(0);
+        case ActivationType::LEAKY_RELU: return x > 0 ? Scalar(1) : static_cast<Scalar>(alpha);
+        case ActivationType::SIGMOID: {
+            const Scalar s = FastMath::sigmoid(x);
+            return s * (1 - s);
+        }
+        case ActivationType::TANH: {
+            const Scalar t = FastMath::tanh(x);
+            return 1 - t * t;
+        }
+        case ActivationType::LINEAR:     return Scalar(1);
+        case ActivationType::SELU:
+            return static_cast<Scalar>((x > 0) ? lambda : lambda * alpha * FastMath::exp(x));
+        default:
+            throw std::invalid_argument("activationDerivative: activation is not element-wise");
+    }
+}
+
+/**
+ * @brief Computes an element-wise activation derivative from the activation's output.
+ *
+ * Every supported element-wise activation has a derivative expressible in
+ * terms of y = f(x), so layers can cache outputs and skip recomputing exp/tanh:
+ * sigmoid y(1 - y), tanh 1 - y², SELU y + λα for y <= 0. ReLU-family layers
+ * normally use a bitmask instead (see activationForwardMasked).
+ *
+ * @param y Activation output.
+ * @param act_type Activation type (any except SOFTMAX).
+ * @param alpha Parameter used by Leaky ReLU (must be > 0 here) and SELU.
+ * @param lambda Parameter used by SELU.
+ * @return f'(x) for the x that produced y.
+ */
+inline Scalar activationDerivativeFromOutput(Scalar y, ActivationType act_type, double alpha, double lambda) {
+    switch (act_type) {
+        case ActivationType::RELU:       return y > 0 ? Scalar(1) : Scalar(0);
+        case ActivationType::LEAKY_RELU: return y > 0 ? Scalar(1) : static_cast<Scalar>(alpha);
+        case ActivationType::SIGMOID:    return y * (1 - y);
+        case ActivationType::TANH:       return 1 - y * y;
+        case ActivationType::LINEAR:     return Scalar(1);
+        case ActivationType::SELU:
+            return static_cast<Scalar>((y > 0) ? lambda : y + lambda * alpha);
+        default:
+            throw std::invalid_argument("activationDerivativeFromOutput: activation is not element-wise");
+    }
+}
+
+/**
+ * @brief True for activations whose backward pass only needs the sign of the input
+ *        (ReLU, Leaky ReLU), which layers store as a one-bit-per-element mask.
+ */
+inline bool usesSignMask(ActivationType act_type) {
+    return act_type == ActivationType::RELU || act_type == ActivationType::LEAKY_RELU;
+}
+
+/**
+ * @brief Number of 64-bit words needed for a sign mask of n elements.
+ */
+inline size_t signMaskWords(size_t n) {
+    return (n + 63) / 64;
+}
+
+/**
+ * @brief Applies an activation into a caller-provided buffer without allocating.
+ *
+ * @param x Input values (n).
+ * @param y Output values (n); may alias x for an in-place update.
+ * @param n Number of elements.
+ * @param act_type Activation type (SOFTMAX is applied over all n elements).
+ * @param alpha Parameter used by Leaky ReLU and SELU.
+ * @param lambda Parameter used by SELU.
+ */
+void activationForward(const Scalar* x, Scalar* y, size_t n, ActivationType act_type,
+                       double alpha = 0.01, double lambda = 1.0507);
+
+/**
+ * @brief ReLU / Leaky ReLU forward that also records the sign mask for backward.
+ *
+ * @param x Input values (n).
+ * @param y Output values (n); may alias x.
+ * @param mask Sign mask, signMaskWords(n) words; bit i is set when x[i] > 0.
+ * @param n Number of elements.
+ * @param act_type RELU or LEAKY_RELU.
+ * @param alpha Leaky ReLU slope.
+ */
+void activationForwardMasked(const Scalar* x, Scalar* y, uint64_t* mask, size_t n,
+                             ActivationType act_type, double alpha = 0.01);
+
+/**
+ * @brief Multiplies a gradient in place by the activation derivative, using cached outputs.
+ *
+ * @param y Cached activation outputs (n).
+ * @param grad Gradient w.r.t. the output on entry, w.r.t. the input on exit (n).
+ * @param n Number of elements.
+ * @param act_type Activation type. SOFTMAX leaves grad unchanged (handled by the loss).
+ * @param alpha Parameter used by Leaky ReLU and SELU.
+ * @param lambda Parameter used by SELU.
+ */
+void activationBackwardFromOutput(const Scalar* y, Scalar* grad, size_t n, ActivationType act_type,
+                                  double alpha = 0.01, double lambda = 1.0507);
+
+/**
+ * @brief Multiplies a gradient in place by the ReLU / Leaky ReLU derivative stored in a sign mask.
+ *
+ * @param mask Sign mask written by activationForwardMasked.
+ * @param grad Gradient, updated in place (n).
+ * @param n Number of elements.
+ * @param act_type RELU or LEAKY_RELU.
+ * @param alpha Leaky ReLU slope.
+ */
+void activationBackwardMasked(const uint64_t* mask, Scalar* grad, size_t n,
+                              ActivationType act_type, double alpha = 0.01);
+
 /**
  * @brief Converts activation type to its string representation.
  * 
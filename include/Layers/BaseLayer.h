@@ -3,7 +3,15 @@
 
 #include <vector>
 #include <string>
+#include <memory>
+#include <algorithm>
 #include <iostream>
+#include "../Utils/Precision.h"
+#include "../Utils/MatrixView.h"
+#include "CachePool.h"
+
+class ParameterRegistry;
+struct ParameterSpan;
 
 /**
  * @brief Abstract base class representing a generic neural network layer.
@@ -17,7 +25,7 @@ public:
      * @param input Input vector for the layer.
      * @return Output vector after applying the layer transformation.
      */
-    virtual std::vector<double> forward(const std::vector<double>& input) = 0;
+    virtual std::vector<Scalar> forward(const std::vector<Scalar>& input) = 0;
 
     /**
      * @brief Performs the backward pass computation (backpropagation).
@@ -25,13 +33,167 @@ public:
      * @param learning_rate Learning rate used for updating parameters (if applicable).
      * @return Gradient vector with respect to the input of this layer.
      */
-    virtual std::vector<double> backward(const std::vector<double>& grad_output) = 0;
+    virtual std::vector<Scalar> backward(const std::vector<Scalar>& grad_output) = 0;
+
+    /**
+     * @brief Forward pass that replaces the buffer with the layer's output.
+     *
+     * Layers that can transform their input in place (e.g. activations)
+     * override this to avoid allocating an output vector.
+     *
+     * @param x Input on entry, output on exit.
+     */
+    virtual void forwardInPlace(std::vector<Scalar>& x) {
+        x = forward(x);
+    }
+
+    /**
+     * @brief Backward pass that replaces the buffer with the input gradient.
+     * @param grad Gradient w.r.t. the output on entry, w.r.t. the input on exit.
+     */
+    virtual void backwardInPlace(std::vector<Scalar>& grad) {
+        grad = backward(grad);
+    }
+
+    /**
+     * @brief Width of the output produced for an input of the given width.
+     *
+     * Used by Sequential::compile to infer every activation and gradient shape.
+     *
+     * @throws std::invalid_argument If the layer cannot take that input width.
+     */
+    virtual size_t outputSize(size_t input_size) const = 0;
+
+    /**
+     * @brief Whether forwardInto/backwardInto may write over their own input.
+     *
+     * Element-wise layers return true so an execution plan can run them in place.
+     */
+    virtual bool isElementWise() const { return false; }
+
+    /**
+     * @brief Forward pass between caller-owned buffers.
+     *
+     * Layers override this to run without heap allocation once their caches
+     * have grown; the default goes through forward().
+     *
+     * @param input Input [input_size].
+     * @param input_size Width of the input.
+     * @param output Output [outputSize(input_size)]; may equal input only if isElementWise().
+     */
+    virtual void forwardInto(const Scalar* input, size_t input_size, Scalar* output) {
+        const std::vector<Scalar> result = forward(std::vector<Scalar>(input, input + input_size));
+        std::copy(result.begin(), result.end(), output);
+    }
+
+    /**
+     * @brief Backward pass between caller-owned buffers.
+     *
+     * @param grad_output Gradient w.r.t. the output [output_size].
+     * @param output_size Width of the output gradient.
+     * @param grad_input Gradient w.r.t. the input; may equal grad_output only if isElementWise().
+     */
+    virtual void backwardInto(const Scalar* grad_output, size_t output_size, Scalar* grad_input) {
+        const std::vector<Scalar> result = backward(std::vector<Scalar>(grad_output, grad_output + output_size));
+        std::copy(result.begin(), result.end(), grad_input);
+    }
+
+    /**
+     * @brief Inference-only forward pass: no caches are written.
+     *
+     * Reads only the layer's parameters, so any number of threads may call it
+     * on the same layer concurrently. Used by Sequential::predict.
+     *
+     * @param input Input [input_size].
+     * @param input_size Width of the input.
+     * @param output Output [outputSize(input_size)]; may equal input only if isElementWise().
+     */
+    virtual void predictInto(const Scalar* input, size_t input_size, Scalar* output) const = 0;
+
+    /**
+     * @brief Inference over a block of rows (const, no caches).
+     *
+     * Dense layers override this to reuse each weight row across the whole
+     * block; the default runs predictInto row by row.
+     *
+     * @param input [rows x input_size].
+     * @param output [rows x outputSize(input_size)]; may equal input only if isElementWise().
+     */
+    virtual void predictBatch(ConstMatrixView input, MatrixView output) const {
+        for (size_t r = 0; r < input.rows; ++r) {
+            predictInto(input.row(r), input.cols, output.row(r));
+        }
+    }
+
+    /**
+     * @brief Frees the activation cache kept for backward (default: nothing to free).
+     *
+     * The next training forward pass rebuilds it; backward before that throws.
+     * See recycleCache() for the variant that keeps the buffers' capacity.
+     */
+    virtual void releaseCache() {}
+
+    /**
+     * @brief Like releaseCache(), but hands the emptied buffers to a pool.
+     *
+     * Used by Sequential's activation checkpointing, which keeps the caches of
+     * only one segment of layers alive at a time. Default: releaseCache().
+     */
+    virtual void recycleCache(CachePool& /*pool*/) { releaseCache(); }
+
+    /**
+     * @brief Takes pooled buffers for caches that have no storage (default: none).
+     *
+     * Called before a forward pass that rebuilds released caches, so the pass
+     * reuses recycled storage instead of allocating.
+     */
+    virtual void adoptCache(CachePool& /*pool*/) {}
+
+    /**
+     * @brief Adds this layer's trainable buffers to a registry (default: none).
+     *
+     * Layers with parameters add one ParameterGroup of value/gradient spans
+     * into their own storage. Called once per registry build, never per step.
+     */
+    virtual void registerParameters(ParameterRegistry& /*registry*/) {}
+
+    /**
+     * @brief Notifies the layer that its parameter values were written through the registry.
+     */
+    virtual void parametersChanged() {}
+
+    /**
+     * @brief Notifies the layer that only the values of these spans were written (default: parametersChanged).
+     *
+     * Called instead of parametersChanged for groups that cover part of the
+     * layer (ParameterRegistry::addRows), so derived copies of the parameters
+     * can be refreshed for the written spans only.
+     */
+    virtual void spansChanged(const std::vector<ParameterSpan>& /*spans*/) { parametersChanged(); }
+
+    /**
+     * @brief Moves the registered values and gradients into caller-owned buffers.
+     *
+     * values and grads hold this layer's registered count, in the offset
+     * order of its ParameterGroup. The current contents are copied in and the
+     * layer uses the buffers from then on; nullptr moves them back into
+     * layer-owned storage. Used by Sequential::flattenParameters.
+     */
+    virtual void bindParameters(Scalar* /*values*/, Scalar* /*grads*/) {}
 
     /**
      * @brief Prints a summary of the layer.
      */
     virtual void summary() const = 0;
 
+    /**
+     * @brief Creates an independent copy of the layer (parameters, caches and gradients).
+     *
+     * Used to give every data-parallel worker its own activation caches and
+     * gradient buffers.
+     */
+    virtual std::unique_ptr<BaseLayer> clone() const = 0;
+
     /**
      * @brief Virtual destructor for proper cleanup.
      */
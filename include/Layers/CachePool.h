@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../Utils/Precision.h"
+
+/**
+ * @file CachePool.h
+ * @brief Spare backward-cache buffers handed from one layer to another.
+ */
+
+/**
+ * @class CachePool
+ * @brief Free list of emptied cache buffers, kept with their capacity.
+ *
+ * Activation checkpointing rebuilds one segment's caches at a time. Instead
+ * of freeing a segment's buffers after its backward pass, the layers give
+ * them to the pool (BaseLayer::recycleCache), and the next segment's layers
+ * take them back (BaseLayer::adoptCache) before recomputing. The same set of
+ * buffers circulates, so only the first samples allocate, and at most two
+ * segments' worth of buffers exist.
+ */
+class CachePool {
+private:
+    std::vector<std::vector<Scalar>> scalars;
+    std::vector<std::vector<uint16_t>> halves;
+    std::vector<std::vector<uint64_t>> words;
+
+    std::vector<std::vector<Scalar>>& list(std::vector<Scalar>*) { return scalars; }
+    std::vector<std::vector<uint16_t>>& list(std::vector<uint16_t>*) { return halves; }
+    std::vector<std::vector<uint64_t>>& list(std::vector<uint64_t>*) { return words; }
+
+public:
+    /**
+     * @brief Empties buffer and moves its storage into the pool (no-op without storage).
+     */
+    template <typename T>
+    void give(std::vector<T>& buffer) {
+        if (buffer.capacity() == 0) return;
+        buffer.clear();
+        list(&buffer).push_back(std::move(buffer));
+        buffer = std::vector<T>();
+    }
+
+    /**
+     * @brief Moves a pooled, empty buffer into buffer if it has no storage yet.
+     */
+    template <typename T>
+    void take(std::vector<T>& buffer) {
+        auto& spare = list(&buffer);
+        if (buffer.capacity() != 0 || spare.empty()) return;
+        buffer = std::move(spare.back());
+        spare.pop_back();
+    }
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "DenseLayer.h"
+#include "Activation_utils.h"
+
+/**
+ * @class DenseActivationLayer
+ * @brief Dense layer with an element-wise activation fused into its epilogue.
+ *
+ * Equivalent to a DenseLayer followed by an ActivationLayer, but:
+ * - forward applies bias add and activation while each output is still in
+ *   a register, producing the activated output in one pass;
+ * - only the activated output is cached (a sign bitmask for ReLU and
+ *   Leaky ReLU), not a separate copy of the activation layer's input;
+ * - backward forms dL/dz = dL/dy * f'(z) from that cache, without
+ *   re-evaluating exp/tanh, in the same pass that accumulates weight and
+ *   bias gradients.
+ *
+ * Being a DenseLayer, it is initialized and updated by optimizers exactly
+ * like a plain dense layer. Softmax is not element-wise and cannot be fused.
+ */
+class DenseActivationLayer : public DenseLayer {
+private:
+    ActivationType activation_type;     ///< Fused activation
+    double alpha;                       ///< Parameter for Leaky ReLU and SELU
+    double lambda;                      ///< Parameter for SELU
+    std::vector<Scalar> output_cache;   ///< Cached y = f(Wx + b) for backward
+    std::vector<uint64_t> sign_mask;    ///< ReLU / Leaky ReLU: sign of Wx + b instead of output_cache
+    bool forward_cached = false;        ///< Set once forward has filled the caches
+    std::vector<Scalar> delta;          ///< Scratch dL/dz buffer
+
+    /**
+     * @brief Applies the activation to z in place and records the backward cache.
+     */
+    void activateAndCache(Scalar* z);
+
+    /**
+     * @brief Fills delta with dL/dz from the cached output or sign mask.
+     */
+    void computeDelta(const Scalar* grad_output);
+
+public:
+    /**
+     * @brief Constructs a fused dense + activation layer.
+     * @param in_features Input dimension
+     * @param out_features Output dimension
+     * @param act_type Fused activation (any except SOFTMAX)
+     * @param alpha Parameter for Leaky ReLU (default 0.01) and SELU (default 1.67326)
+     * @param lambda Parameter for SELU (default 1.0507)
+     */
+    DenseActivationLayer(size_t in_features, size_t out_features, ActivationType act_type,
+                         double alpha = 0.01, double lambda = 1.0507);
+
+    /**
+     * @brief Fuses an existing dense layer (parameters are copied) with an activation.
+     * @param dense Dense layer providing weights, biases and storage precision
+     * @param act_type Fused activation (any except SOFTMAX)
+     * @param alpha Parameter for Leaky ReLU and SELU (used as given)
+     * @param lambda Parameter for SELU
+     */
+    DenseActivationLayer(const DenseLayer& dense, ActivationType act_type,
+                         double alpha, double lambda);
+
+    /**
+     * @brief Fused forward pass: y = f(Wx + b).
+     * @param input Input vector (size: input_size).
+     * @return Activated output (size: output_size).
+     */
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) override;
+
+    /**
+     * @brief Fused backward pass through the activation and the dense transform.
+     * @param grad_output Gradient w.r.t. the activated output (size: output_size).
+     * @return Gradient w.r.t. the input (size: input_size).
+     */
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output) override;
+
+    /**
+     * @brief Fused forward pass into a caller-owned output buffer.
+     */
+    void forwardInto(const Scalar* input, size_t input_size, Scalar* output) override;
+
+    /**
+     * @brief Fused backward pass into a caller-owned input-gradient buffer.
+     */
+    void backwardInto(const Scalar* grad_output, size_t output_size, Scalar* grad_input) override;
+
+    /**
+     * @brief Cache-free fused forward pass: dense kernel, then the activation in place.
+     */
+    void predictInto(const Scalar* input, size_t input_size, Scalar* output) const override;
+
+    /**
+     * @brief Blocked dense kernel, then the activation over every output row.
+     */
+    void predictBatch(ConstMatrixView input, MatrixView output) const override;
+
+    /**
+     * @brief Prints a summary of the fused layer.
+     */
+    void summary() const override;
+
+    /**
+     * @brief Creates a copy of the layer with its own caches.
+     */
+    std::unique_ptr<BaseLayer> clone() const override;
+
+    /**
+     * @brief Frees the cached input, activated output / sign mask and delta scratch.
+     */
+    void releaseCache() override;
+
+    /**
+     * @brief Gives the input, output / sign mask and delta buffers to a pool.
+     */
+    void recycleCache(CachePool& pool) override;
+
+    /**
+     * @brief Takes pooled buffers for the input and activation caches.
+     */
+    void adoptCache(CachePool& pool) override;
+
+    /**
+     * @brief Switches the storage format and invalidates the forward cache.
+     */
+    void setStoragePrecision(StoragePrecision precision) override;
+
+    /**
+     * @brief Retrieves the fused activation type.
+     */
+    ActivationType getActivationType() const;
+
+    /**
+     * @brief Retrieves the alpha parameter (Leaky ReLU slope / SELU alpha).
+     */
+    double getAlpha() const;
+
+    /**
+     * @brief Retrieves the lambda parameter (SELU scale).
+     */
+    double getLambda() const;
+};
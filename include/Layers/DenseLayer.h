@@ -1,7 +1,13 @@
 #pragma once 
 
 #include "BaseLayer.h"
+#include "ParameterStorage.h"
 #include "../Utils/Initialization.h"
+#include "../Utils/HalfPrecision.h"
+#include "../Utils/ThreadPool.h"
+#include "../Utils/Reduction.h"
+#include <utility>
+#include <stdexcept>
 #include <cstddef>
 #include <vector>
 
@@ -14,16 +20,53 @@
  * - Various weight initialization methods (Xavier, He, etc.)
  * - Batch and stochastic gradient descent
  * - Activation-agnostic design (pair with activation layers)
+ * - Optional bf16/fp16 storage of weight copies and cached activations
+ *   (mixed precision); the Scalar weights remain the master copy that
+ *   optimizers update.
  */
 class DenseLayer : public BaseLayer {
-private:
+protected:
     size_t input_size;                          ///< Number of input features
     size_t output_size;                         ///< Number of output neurons
-    std::vector<std::vector<double>> weights;   ///< Weight matrix [input_size x output_size]
-    std::vector<double> biases;                 ///< Bias vector [output_size]
-    std::vector<std::vector<double>> grad_weights; ///< Weight gradients
-    std::vector<double> grad_biases;            ///< Bias gradients
-    std::vector<double> input_cache;            ///< Cached inputs for backpropagation
+    ParameterStorage parameters;                ///< [weights row-major | biases] and their gradients
+    bool weights_initialized = false;           ///< Set by initializeWeights / setWeights
+    bool biases_initialized = false;            ///< Set by initializeBiases / setBiases
+    std::vector<Scalar> input_cache;            ///< Cached inputs for backpropagation
+
+    // Mixed-precision storage
+    StoragePrecision storage_precision = StoragePrecision::NATIVE; ///< Format of weight copy / input cache
+    std::vector<uint16_t> weights_lowp;         ///< 16-bit weight copy [output_size * input_size]
+    std::vector<uint16_t> input_cache_lowp;     ///< 16-bit cached inputs [input_size]
+    std::vector<Scalar> decode_buffer;          ///< Scratch row for decoding 16-bit values
+    std::vector<Scalar> decoded_input;          ///< Scratch for the decoded 16-bit input cache
+
+    /**
+     * @brief Row i of the weight matrix [input_size]; rows are contiguous.
+     */
+    Scalar* weightRow(size_t i) const { return parameters.values() + i * input_size; }
+
+    /**
+     * @brief Bias vector [output_size], stored right after the weights.
+     */
+    Scalar* biasData() const { return parameters.values() + output_size * input_size; }
+
+    Scalar* gradWeightRow(size_t i) const { return parameters.grads() + i * input_size; }
+    Scalar* gradBiasData() const { return parameters.grads() + output_size * input_size; }
+
+    /**
+     * @brief y = Wx + b on raw buffers; caches the input (Scalar or 16-bit).
+     */
+    void forwardKernel(const Scalar* input, Scalar* output);
+
+    /**
+     * @brief Input gradient (overwritten) and accumulated parameter gradients on raw buffers.
+     */
+    void backwardKernel(const Scalar* grad_output, Scalar* grad_input);
+
+    /**
+     * @brief Backward pass used when storage precision is BF16/FP16.
+     */
+    void backwardLowPrecision(const Scalar* grad_output, Scalar* grad_input);
 
 public:
     /**
@@ -84,7 +127,7 @@ public:
      * @param input A vector representing the input to the layer (size: input_size).
      * @return A vector representing the output of the layer (size: output_size).
      */
-    std::vector<double> forward(const std::vector<double>& input) override;
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) override;
 
     /**
      * @brief Backward pass to compute gradients of the loss with respect to the weights and biases.
@@ -96,7 +139,59 @@ public:
      * @param lr The learning rate used for gradient descent (default: 0.01).
      * @return The gradient of the loss with respect to the input (size: input_size).
      */
-    std::vector<double> backward(const std::vector<double>& grad_output) override;
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output) override;
+
+    /**
+     * @brief Forward pass into a caller-owned output buffer (no allocation once cached).
+     */
+    void forwardInto(const Scalar* input, size_t input_size, Scalar* output) override;
+
+    /**
+     * @brief Backward pass into a caller-owned input-gradient buffer.
+     */
+    void backwardInto(const Scalar* grad_output, size_t output_size, Scalar* grad_input) override;
+
+    /**
+     * @brief Cache-free y = Wx + b; const and safe to call from several threads.
+     */
+    void predictInto(const Scalar* input, size_t input_size, Scalar* output) const override;
+
+    /**
+     * @brief Cache-free y = Wx + b over a block of rows; each weight row is read once per block.
+     */
+    void predictBatch(ConstMatrixView input, MatrixView output) const override;
+
+    /**
+     * @brief Returns output_size; throws std::invalid_argument unless input_size matches.
+     */
+    size_t outputSize(size_t input_size) const override;
+
+    /**
+     * @brief Forward pass restricted to a subset of output neurons.
+     *
+     * Computes output[k] = W[rows[k]] . input + b[rows[k]] only, so the cost is
+     * O(rows.size() * input_size) instead of O(output_size * input_size). Used
+     * with sampled softmax on very large output layers. Caches the input like forward().
+     *
+     * @param input Input vector (size: input_size).
+     * @param rows Output neuron indices to evaluate (each < output_size, repeats allowed).
+     * @param output Receives rows.size() values (resized, capacity reused).
+     */
+    void forwardSampled(const std::vector<Scalar>& input, const std::vector<size_t>& rows,
+                        std::vector<Scalar>& output);
+
+    /**
+     * @brief Backward pass for forwardSampled: scatters gradients into the sampled rows.
+     *
+     * Only grad_weights[rows[k]] and grad_biases[rows[k]] are touched.
+     *
+     * @param grad_output Gradient w.r.t. the sampled outputs (size: rows.size()).
+     * @param rows Same indices passed to forwardSampled.
+     * @param grad_input Receives the gradient w.r.t. the input (size: input_size).
+     */
+    void backwardSampled(const std::vector<Scalar>& grad_output, const std::vector<size_t>& rows,
+                         std::vector<Scalar>& grad_input);
+
     
 //////////////////////
 // Utility functions//
@@ -110,6 +205,26 @@ public:
      */
     void summary() const override;
 
+    /**
+     * @brief Creates a copy of the layer with its own caches and gradient buffers.
+     */
+    std::unique_ptr<BaseLayer> clone() const override;
+
+    /**
+     * @brief Frees the cached input (Scalar or 16-bit); the next forward pass rebuilds it.
+     */
+    void releaseCache() override;
+
+    /**
+     * @brief Gives the cached input buffers to a pool, keeping their capacity.
+     */
+    void recycleCache(CachePool& pool) override;
+
+    /**
+     * @brief Takes pooled buffers for the input caches.
+     */
+    void adoptCache(CachePool& pool) override;
+
     /**
      * @brief Clears the gradients stored in the layer.
      *
@@ -128,6 +243,80 @@ public:
      */
     size_t getParameterCount() const;
 
+    /**
+     * @brief Multiplies the accumulated gradients by a constant factor.
+     *
+     * Used to unscale gradients when dynamic loss scaling is enabled.
+     *
+     * @param factor Scale factor applied to every weight and bias gradient.
+     */
+    void scaleGradients(double factor);
+
+    /**
+     * @brief Checks that all accumulated gradients are finite.
+     * @return false if any gradient is NaN or infinite.
+     */
+    bool hasFiniteGradients() const;
+
+    /**
+     * @brief Registers one span for the weights and one for the biases.
+     *
+     * Offsets follow the flat layout [weights row-major | biases] of
+     * getParameterCount() values, so optimizers can index a flat state buffer;
+     * weight_count is input_size * output_size.
+     */
+    void registerParameters(ParameterRegistry& registry) override;
+
+    /**
+     * @brief Moves weights, biases and their gradients into an external buffer.
+     */
+    void bindParameters(Scalar* values, Scalar* grads) override;
+
+    /**
+     * @brief Whether both weights and biases have been set.
+     */
+    bool isInitialized() const;
+
+    /**
+     * @brief Re-encodes the 16-bit weight copy after an optimizer update.
+     */
+    void parametersChanged() override;
+
+    /**
+     * @brief Re-encodes the 16-bit copy of the written weight spans only.
+     */
+    void spansChanged(const std::vector<ParameterSpan>& spans) override;
+
+////////////////////
+// Mixed precision//
+////////////////////
+
+    /**
+     * @brief Selects the storage format for the weight copy and input cache.
+     *
+     * With BF16/FP16 the forward and backward passes read weights and cached
+     * inputs from 16-bit buffers (halving their memory traffic) while the
+     * Scalar weights stay the master copy updated by the optimizer. The
+     * cached input is dropped in either direction, so backward needs a new
+     * forward pass after a switch.
+     *
+     * @param precision NATIVE, BF16 or FP16.
+     */
+    virtual void setStoragePrecision(StoragePrecision precision);
+
+    /**
+     * @brief Gets the storage format of the weight copy and input cache.
+     */
+    StoragePrecision getStoragePrecision() const;
+
+    /**
+     * @brief Re-encodes the 16-bit weight copy from the master weights.
+     *
+     * Called through parametersChanged after the master weights were written
+     * through the registry.
+     */
+    void refreshLowPrecisionWeights();
+
 //////////////
 // Debugging//
 //////////////
@@ -153,30 +342,35 @@ public:
     /**
      * @brief Gets the current weight matrix.
      * 
-     * @return A reference to the weight matrix (size: input_size x output_size).
+     * @return A view of the weight matrix (size: output_size x input_size).
      */
-    const std::vector<std::vector<double>>& getWeights() const;
+    ConstMatrixView getWeights() const;
 
     /**
      * @brief Gets the current bias vector.
      * 
-     * @return A reference to the bias vector (size: output_size).
+     * @return Pointer to the bias vector (size: output_size).
      */
-    const std::vector<double>& getBiases() const;
+    const Scalar* getBiases() const;
 
     /**
      * @brief Gets the gradient of the weights.
      * 
-     * @return A reference to the gradient of the weights (size: input_size x output_size).
+     * @return A view of the gradient of the weights (size: output_size x input_size).
      */
-    const std::vector<std::vector<double>>& getGradWeights() const;
+    ConstMatrixView getGradWeights() const;
     
     /**
      * @brief Gets the gradient of the biases.
      * 
-     * @return A reference to the gradient of the biases (size: output_size).
+     * @return Pointer to the gradient of the biases (size: output_size).
+     */
+    const Scalar* getGradBiases() const;
+
+    /**
+     * @brief Gets the number of output neurons.
      */
-    const std::vector<double>& getGradBiases() const;
+    size_t getOutputSize() const;
 
 /////////////
 // Mutators//
@@ -189,9 +383,9 @@ public:
      *
      * @param new_weights The new weight matrix to set (size: input_size x output_size).
      */
-    void setWeights(std::vector<std::vector<double>>& new_weights); // copy
+    void setWeights(std::vector<std::vector<Scalar>>& new_weights); // copy
 
-    void setWeights(std::vector<std::vector<double>>&& new_weights); // move
+    void setWeights(std::vector<std::vector<Scalar>>&& new_weights); // move
 
     /**
      * @brief Sets the biases of the layer.
@@ -200,7 +394,7 @@ public:
      *
      * @param new_biases The new bias vector to set (size: output_size).
      */
-    void setBiases(std::vector<double>& new_biases); // copy 
+    void setBiases(std::vector<Scalar>& new_biases); // copy 
 
-    void setBiases(std::vector<double>&& new_biases); // move
+    void setBiases(std::vector<Scalar>&& new_biases); // move
 };
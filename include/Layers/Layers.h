@@ -3,5 +3,9 @@
 
 #include "DenseLayer.h"
 #include "ActivationLayer.h"
+#include "DenseActivationLayer.h"
+#include "StaticDenseLayer.h"
+#include "StaticActivationLayer.h"
+#include "ParameterRegistry.h"
 
 #endif // LAYERS_H
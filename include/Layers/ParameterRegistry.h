@@ -0,0 +1,208 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "BaseLayer.h"
+#include "../Utils/Precision.h"
+#include "../Utils/ThreadPool.h"
+#include "../Utils/Reduction.h"
+
+/**
+ * @file ParameterRegistry.h
+ * @brief Prebuilt table of the trainable buffers of a layer stack.
+ *
+ * Every layer describes its parameters once through
+ * BaseLayer::registerParameters, as spans of values with their matching
+ * gradients. Optimizers, gradient zeroing, loss scaling and gradient
+ * clipping then walk this table; the hot path needs no RTTI and builds no
+ * temporary layer lists. Spans point into the layers' own storage, so a
+ * registry must be rebuilt after a layer reallocates its parameters
+ * (Sequential rebuilds its registry at the start of every training call).
+ *
+ * Long spans are split into chunks of at most kChunkSize values, the unit
+ * of parallel work. When all spans happen to be one contiguous run (see
+ * Sequential::flattenParameters), values() and gradients() expose it and the
+ * whole-model passes become single linear sweeps.
+ */
+
+/**
+ * @brief One contiguous run of trainable values and their gradients.
+ */
+struct ParameterSpan {
+    Scalar* values = nullptr;
+    Scalar* grads = nullptr;
+    size_t size = 0;
+    size_t offset = 0;      ///< Index of values[0] in the layer's flattened [weights | biases]
+};
+
+/**
+ * @brief Trainable buffers of one layer.
+ *
+ * Offsets below weight_count are weights; the rest are biases, which LARS
+ * and LAMB exclude from weight decay and trust ratios.
+ */
+struct ParameterGroup {
+    BaseLayer* layer = nullptr;         ///< Owner; key for per-layer optimizer state
+    std::vector<ParameterSpan> spans;   ///< Ordered by offset
+    size_t count = 0;                   ///< Total number of values
+    size_t weight_count = 0;            ///< Values before the first bias
+    size_t grain = 1;                   ///< Spans per parallel task (about kChunkSize values)
+    bool partial = false;               ///< Spans cover only some rows (see ParameterRegistry::addRows)
+};
+
+class ParameterRegistry {
+private:
+    std::vector<ParameterGroup> groups;
+    size_t total_count = 0;
+    Scalar* flat_values = nullptr;      ///< Start of the values if all spans are contiguous
+    Scalar* flat_grads = nullptr;       ///< Start of the gradients, likewise
+    bool contiguous = true;
+
+public:
+    static constexpr size_t kChunkSize = 16384;     ///< Values per span after splitting
+
+    ParameterRegistry() = default;
+
+    /**
+     * @brief Registers the parameters of every layer in order.
+     */
+    explicit ParameterRegistry(const std::vector<BaseLayer*>& layers);
+
+    /**
+     * @brief Drops all groups (capacity is kept for the next build).
+     */
+    void clear();
+
+    /**
+     * @brief Asks a layer to register its parameters (layers without any add nothing).
+     */
+    void add(BaseLayer& layer);
+
+    /**
+     * @brief Called by BaseLayer::registerParameters; splits long spans, computes count and grain.
+     * @throws std::invalid_argument If the spans are not contiguous in offset.
+     */
+    void addGroup(ParameterGroup group);
+
+    /**
+     * @brief Adds the part of a registered group that belongs to some output rows.
+     *
+     * For layers laid out as [weights row-major | biases] with one bias per
+     * row (DenseLayer). Every listed row contributes its weight row and its
+     * bias as spans at their offsets in the full layout. count and
+     * weight_count stay those of the full group, so per-layer optimizer state
+     * keeps its layout: rows not listed are neither updated nor have their
+     * state advanced (lazy sparse updates). Used by Sequential::trainSampled.
+     *
+     * @param full Group the layer registered.
+     * @param row_size Weights per row.
+     * @param rows Distinct row indices, ascending.
+     * @throws std::invalid_argument If full does not have that layout or a row is out of range.
+     */
+    void addRows(const ParameterGroup& full, size_t row_size, const std::vector<size_t>& rows);
+
+    const std::vector<ParameterGroup>& getGroups() const { return groups; }
+    size_t size() const { return groups.size(); }
+    bool empty() const { return groups.empty(); }
+
+    /**
+     * @brief Total number of trainable values.
+     */
+    size_t parameterCount() const { return total_count; }
+
+    /**
+     * @brief Whether all values (and all gradients) form one run, in registration order.
+     */
+    bool isContiguous() const { return contiguous && total_count > 0; }
+
+    /**
+     * @brief All values [parameterCount()] if isContiguous(), else nullptr.
+     *
+     * Checkpoints and cross-process exchange can read or write this in one go.
+     */
+    Scalar* values() const { return isContiguous() ? flat_values : nullptr; }
+
+    /**
+     * @brief All gradients [parameterCount()] if isContiguous(), else nullptr.
+     */
+    Scalar* gradients() const { return isContiguous() ? flat_grads : nullptr; }
+
+    /**
+     * @brief Sets every gradient to zero.
+     */
+    void zeroGradients() const;
+
+    /**
+     * @brief Multiplies every gradient by factor (loss-scaling support).
+     */
+    void scaleGradients(double factor) const;
+
+    /**
+     * @brief False if any gradient is Inf or NaN.
+     */
+    bool gradientsFinite() const;
+
+    /**
+     * @brief Deterministic sum of squared gradients over all groups.
+     */
+    double gradientSquaredNorm() const;
+
+    /**
+     * @brief Runs an in-place update kernel over every span of a group, in parallel.
+     *
+     * The kernel may write values and gradients of its span only. Afterwards
+     * the owner is told through BaseLayer::parametersChanged (e.g. to
+     * re-encode 16-bit weight copies), or BaseLayer::spansChanged for a
+     * partial group.
+     *
+     * @param kernel Callable void(Scalar* values, Scalar* grads, size_t n, size_t offset).
+     */
+    template <typename Kernel>
+    static void update(const ParameterGroup& group, Kernel&& kernel);
+
+    /**
+     * @brief Deterministic reduction of kernel results over a group.
+     * @param kernel Callable double(Scalar* values, Scalar* grads, size_t n, size_t offset).
+     * @return {sum over weight spans, sum over bias spans}.
+     */
+    template <typename Kernel>
+    static std::pair<double, double> reduce(const ParameterGroup& group, Kernel&& kernel);
+};
+
+template <typename Kernel>
+void ParameterRegistry::update(const ParameterGroup& group, Kernel&& kernel)
+{
+    ThreadPool::global().parallelFor(0, group.spans.size(), [&](size_t lo, size_t hi) {
+        for (size_t s = lo; s < hi; ++s) {
+            const ParameterSpan& span = group.spans[s];
+            kernel(span.values, span.grads, span.size, span.offset);
+        }
+    }, group.grain);
+    if (group.partial) {
+        group.layer->spansChanged(group.spans);
+    } else {
+        group.layer->parametersChanged();
+    }
+}
+
+template <typename Kernel>
+std::pair<double, double> ParameterRegistry::reduce(const ParameterGroup& group, Kernel&& kernel)
+{
+    // Weight spans precede bias spans
+    size_t num_weight_spans = 0;
+    while (num_weight_spans < group.spans.size() &&
+           group.spans[num_weight_spans].offset < group.weight_count) {
+        ++num_weight_spans;
+    }
+
+    const double weight_result = Reduction::sum(num_weight_spans, [&](size_t s) {
+        const ParameterSpan& span = group.spans[s];
+        return kernel(span.values, span.grads, span.size, span.offset);
+    }, group.grain);
+    Reduction::CompensatedSum bias_result;
+    for (size_t s = num_weight_spans; s < group.spans.size(); ++s) {
+        const ParameterSpan& span = group.spans[s];
+        bias_result += kernel(span.values, span.grads, span.size, span.offset);
+    }
+    return {weight_result, bias_result.result()};
+}
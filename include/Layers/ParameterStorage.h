@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "../Utils/Precision.h"
+
+/**
+ * @file ParameterStorage.h
+ * @brief Values and gradients of one layer, owned or bound to a shared buffer.
+ *
+ * A layer keeps its parameters as one contiguous run of values and one of
+ * gradients. By default the storage owns both; bind() moves them into
+ * caller-owned memory, which is how Sequential::flattenParameters packs a
+ * whole model into a single value buffer and a single gradient buffer.
+ */
+class ParameterStorage {
+private:
+    std::vector<Scalar> owned_values;
+    std::vector<Scalar> owned_grads;
+    Scalar* values_ = nullptr;
+    Scalar* grads_ = nullptr;
+    size_t count = 0;
+
+public:
+    ParameterStorage() = default;
+
+    /**
+     * @brief Owned, zero-filled storage for count values and count gradients.
+     */
+    explicit ParameterStorage(size_t count);
+
+    /**
+     * @brief Deep copy; the copy always owns its storage, even if other is bound.
+     */
+    ParameterStorage(const ParameterStorage& other);
+    ParameterStorage& operator=(const ParameterStorage& other);
+
+    /**
+     * @brief Moves values and gradients into external buffers of size() elements each.
+     *
+     * The current contents are copied in first. The buffers must outlive the
+     * binding. bind(nullptr, nullptr) copies them back into owned storage.
+     */
+    void bind(Scalar* values, Scalar* grads);
+
+    bool isBound() const { return count > 0 && values_ != owned_values.data(); }
+    size_t size() const { return count; }
+    Scalar* values() const { return values_; }
+    Scalar* grads() const { return grads_; }
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include "BaseLayer.h"
+#include "Activation_utils.h"
+
+/**
+ * @class StaticActivationLayer
+ * @brief Element-wise activation whose width and type are fixed at compile time.
+ *
+ * Building block of StaticSequential. The activation type is a template
+ * argument, so the switch inside applyActivation /
+ * activationDerivativeFromOutput folds away once inlined. The output is
+ * cached for backward, as in DenseActivationLayer.
+ *
+ * @tparam N Width.
+ * @tparam Act Activation (any except SOFTMAX; use a loss that takes logits instead).
+ */
+template <size_t N, ActivationType Act>
+class StaticActivationLayer final : public BaseLayer {
+    static_assert(N > 0, "StaticActivationLayer: Width must be > 0");
+    static_assert(Act != ActivationType::SOFTMAX, "StaticActivationLayer: Softmax is not element-wise");
+
+private:
+    double alpha;                           ///< Parameter for Leaky ReLU and SELU
+    double lambda;                          ///< Parameter for SELU
+    std::array<Scalar, N> output_cache{};   ///< Output of the last training forward
+
+public:
+    static constexpr size_t input_size = N;
+    static constexpr size_t output_size = N;
+    static constexpr bool is_activation = true;
+    static constexpr ActivationType activation_type = Act;
+
+    /**
+     * @param alpha Parameter for Leaky ReLU (default 0.01) and SELU (default 1.67326)
+     * @param lambda Parameter for SELU (default 1.0507)
+     */
+    explicit StaticActivationLayer(double alpha = 0.01, double lambda = 1.0507)
+        : alpha(Act == ActivationType::SELU && alpha == 0.01 ? 1.67326 : alpha), lambda(lambda) {}
+
+    /**
+     * @brief Training forward pass; output may equal input.
+     */
+    void forward(const Scalar* input, Scalar* output) {
+        for (size_t i = 0; i < N; ++i) {
+            output[i] = applyActivation(input[i], Act, alpha, lambda);
+            output_cache[i] = output[i];
+        }
+    }
+
+    /**
+     * @brief dL/dx = dL/dy * f'(x), from the cached output; grad_input may equal grad_output.
+     */
+    void backward(const Scalar* grad_output, Scalar* grad_input) {
+        if (!grad_input) return;
+        for (size_t i = 0; i < N; ++i) {
+            grad_input[i] = grad_output[i] * activationDerivativeFromOutput(output_cache[i], Act, alpha, lambda);
+        }
+    }
+
+    /**
+     * @brief Cache-free activation; output may equal input.
+     */
+    void predict(const Scalar* input, Scalar* output) const {
+        for (size_t i = 0; i < N; ++i) output[i] = applyActivation(input[i], Act, alpha, lambda);
+    }
+
+    // BaseLayer interface
+
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) override {
+        std::vector<Scalar> output(N);
+        forwardInto(input.data(), input.size(), output.data());
+        return output;
+    }
+
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output) override {
+        std::vector<Scalar> grad_input(N);
+        backwardInto(grad_output.data(), grad_output.size(), grad_input.data());
+        return grad_input;
+    }
+
+    void forwardInto(const Scalar* input, size_t n, Scalar* output) override {
+        outputSize(n);
+        forward(input, output);
+    }
+
+    void backwardInto(const Scalar* grad_output, size_t n, Scalar* grad_input) override {
+        outputSize(n);
+        backward(grad_output, grad_input);
+    }
+
+    void predictInto(const Scalar* input, size_t n, Scalar* output) const override {
+        outputSize(n);
+        predict(input, output);
+    }
+
+    size_t outputSize(size_t n) const override {
+        if (n != N) {
+            throw std::invalid_argument("StaticActivationLayer::outputSize: Expected input size " +
+                                        std::to_string(N) + ", got " + std::to_string(n));
+        }
+        return N;
+    }
+
+    bool isElementWise() const override { return true; }
+
+    void summary() const override {
+        std::cout << "Static Activation Layer: " << activationTypeToString(Act) << " (" << N << ")\n";
+    }
+
+    std::unique_ptr<BaseLayer> clone() const override {
+        return std::make_unique<StaticActivationLayer>(*this);
+    }
+};
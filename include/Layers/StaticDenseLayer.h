@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include "BaseLayer.h"
+#include "ParameterStorage.h"
+#include "ParameterRegistry.h"
+#include "../Utils/Initialization.h"
+
+/**
+ * @class StaticDenseLayer
+ * @brief Dense layer whose shape is fixed at compile time.
+ *
+ * Building block of StaticSequential. Weights [Out x In] and biases [Out]
+ * live in one ParameterStorage run, laid out exactly like DenseLayer, so
+ * the same optimizers, registry and flattening apply. The non-virtual
+ * forward / backward / predict take raw buffers whose sizes are template
+ * constants: called through the concrete type they inline, and every loop
+ * has a compile-time trip count the compiler can unroll.
+ *
+ * The BaseLayer interface is implemented on top of them, so the registry
+ * and optimizers treat it like any other layer.
+ *
+ * @tparam In Input width.
+ * @tparam Out Output width.
+ */
+template <size_t In, size_t Out>
+class StaticDenseLayer final : public BaseLayer {
+    static_assert(In > 0 && Out > 0, "StaticDenseLayer: Input and output widths must be > 0");
+
+private:
+    ParameterStorage parameters{In * Out + Out};    ///< [weights row-major | biases] and gradients
+    std::array<Scalar, In> input_cache{};           ///< Input of the last training forward
+    bool initialized = false;
+
+    /**
+     * @brief y = Wx + b without checks; shared by forward and predict.
+     */
+    void affine(const Scalar* input, Scalar* output) const {
+        const Scalar* weights = weightRow(0);
+        const Scalar* biases = biasData();
+        for (size_t i = 0; i < Out; ++i) {
+            const Scalar* row = weights + i * In;
+            Scalar sum = 0.0;
+            for (size_t j = 0; j < In; ++j) sum += row[j] * input[j];
+            output[i] = sum + biases[i];
+        }
+    }
+
+public:
+    static constexpr size_t input_size = In;
+    static constexpr size_t output_size = Out;
+    static constexpr bool is_activation = false;
+
+    StaticDenseLayer() = default;
+
+    /**
+     * @brief Initializes weights and biases (same generators as DenseLayer).
+     * @param method Weight initialization strategy
+     * @param seed RNG seed
+     * @param a Lower bound / mean
+     * @param b Upper bound / variance
+     * @param sparsity Fraction of weights set to zero
+     * @param bias_value Constant bias value
+     */
+    void initialize(InitMethod method, unsigned int seed, double a = 0, double b = 1.0,
+                    double sparsity = 0.0, double bias_value = 0.1) {
+        const auto weights = initializeParameters(In, Out, method, seed, a, b, sparsity, bias_value);
+        for (size_t i = 0; i < Out; ++i) std::copy(weights[i].begin(), weights[i].end(), weightRow(i));
+        const auto biases = initializeParameters(Out, 1, InitMethod::BIAS, seed, a, b, sparsity, bias_value);
+        std::copy(biases[0].begin(), biases[0].end(), biasData());
+        initialized = true;
+    }
+
+    Scalar* weightRow(size_t i) { return parameters.values() + i * In; }
+    const Scalar* weightRow(size_t i) const { return parameters.values() + i * In; }
+    Scalar* biasData() { return parameters.values() + In * Out; }
+    const Scalar* biasData() const { return parameters.values() + In * Out; }
+
+    /**
+     * @brief Training forward pass y = Wx + b; caches the input.
+     * @throws std::runtime_error If the parameters were never initialized.
+     */
+    void forward(const Scalar* input, Scalar* output) {
+        if (!initialized) {
+            throw std::runtime_error("StaticDenseLayer::forward: Parameters not initialized");
+        }
+        std::copy(input, input + In, input_cache.begin());
+        affine(input, output);
+    }
+
+    /**
+     * @brief Accumulates weight and bias gradients and writes dL/dx.
+     * @param grad_input Gradient w.r.t. the input [In]; nullptr skips it (first layer).
+     */
+    void backward(const Scalar* grad_output, Scalar* grad_input) {
+        const Scalar* weights = weightRow(0);
+        Scalar* grads = parameters.grads();
+        if (grad_input) {
+            std::fill(grad_input, grad_input + In, Scalar(0));
+        }
+        for (size_t i = 0; i < Out; ++i) {
+            const Scalar g = grad_output[i];
+            const Scalar* row = weights + i * In;
+            Scalar* grad_row = grads + i * In;
+            if (grad_input) {
+                for (size_t j = 0; j < In; ++j) grad_input[j] += row[j] * g;
+            }
+            for (size_t j = 0; j < In; ++j) grad_row[j] += g * input_cache[j];
+            grads[In * Out + i] += g;
+        }
+    }
+
+    /**
+     * @brief Cache-free y = Wx + b; const and safe to call from several threads.
+     * @throws std::runtime_error If the parameters were never initialized.
+     */
+    void predict(const Scalar* input, Scalar* output) const {
+        if (!initialized) {
+            throw std::runtime_error("StaticDenseLayer::predict: Parameters not initialized");
+        }
+        affine(input, output);
+    }
+
+    bool isInitialized() const { return initialized; }
+
+    ConstMatrixView getWeights() const { return ConstMatrixView(weightRow(0), Out, In); }
+    const Scalar* getBiases() const { return biasData(); }
+
+    // BaseLayer interface
+
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) override {
+        std::vector<Scalar> output(Out);
+        forwardInto(input.data(), input.size(), output.data());
+        return output;
+    }
+
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output) override {
+        std::vector<Scalar> grad_input(In);
+        backwardInto(grad_output.data(), grad_output.size(), grad_input.data());
+        return grad_input;
+    }
+
+    void forwardInto(const Scalar* input, size_t n, Scalar* output) override {
+        outputSize(n);
+        forward(input, output);
+    }
+
+    void backwardInto(const Scalar* grad_output, size_t n, Scalar* grad_input) override {
+        if (n != Out) {
+            throw std::invalid_argument("StaticDenseLayer::backward: Expected gradient size " +
+                                        std::to_string(Out) + ", got " + std::to_string(n));
+        }
+        backward(grad_output, grad_input);
+    }
+
+    void predictInto(const Scalar* input, size_t n, Scalar* output) const override {
+        outputSize(n);
+        predict(input, output);
+    }
+
+    size_t outputSize(size_t n) const override {
+        if (n != In) {
+            throw std::invalid_argument("StaticDenseLayer::outputSize: Expected input size " +
+                                        std::to_string(In) + ", got " + std::to_string(n));
+        }
+        return Out;
+    }
+
+    void registerParameters(ParameterRegistry& registry) override {
+        if (!initialized) return;
+        ParameterGroup group;
+        group.layer = this;
+        group.weight_count = In * Out;
+        group.spans.push_back({parameters.values(), parameters.grads(), In * Out, 0});
+        group.spans.push_back({biasData(), parameters.grads() + In * Out, Out, In * Out});
+        registry.addGroup(std::move(group));
+    }
+
+    void bindParameters(Scalar* values, Scalar* grads) override {
+        parameters.bind(values, grads);
+    }
+
+    void summary() const override {
+        std::cout << "Static Dense Layer: " << In << " -> " << Out
+                  << " | Parameters: " << In * Out + Out << " ("
+                  << In * Out << " weights, " << Out << " biases)\n";
+    }
+
+    std::unique_ptr<BaseLayer> clone() const override {
+        return std::make_unique<StaticDenseLayer>(*this);
+    }
+};
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <tuple>
+#include <cstddef>
 
 /**
  * @brief Computes dimensions of dataset with validation
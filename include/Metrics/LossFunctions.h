@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <stdexcept>
+#include "Losses.h"
+#include "../Utils/MatrixView.h"
+#include "../Utils/FastMath.h"
+
+/**
+ * @file LossFunctions.h
+ * @brief Allocation-free loss objects operating on contiguous batch spans.
+ *
+ * Every loss object provides
+ * - double forward(y_true, y_pred): mean loss of the batch;
+ * - void backward(y_true, y_pred, grad): gradient of that mean w.r.t. y_pred,
+ *   written into a caller-provided buffer;
+ * - double forwardBackward(y_true, y_pred, grad): both in one pass.
+ *
+ * All spans are [rows x cols] views. The objects are small concrete types
+ * with inline members, so Sequential::train(..., const Loss&) is instantiated
+ * per loss and the per-sample calls inline instead of going through
+ * std::function. Normalisation matches the corresponding *_batch functions
+ * (per element for MSE/MAE/BCE/Hinge, per row for cross entropy), so every
+ * loss is a mean over rows of independent row terms.
+ */
+namespace Losses {
+
+    namespace detail {
+        inline void checkShapes(const char* name, ConstMatrixView y_true, ConstMatrixView y_pred) {
+            if (y_true.rows == 0 || y_true.cols == 0)
+                throw std::invalid_argument(std::string(name) + ": Empty batch.");
+            if (y_true.rows != y_pred.rows || y_true.cols != y_pred.cols)
+                throw std::invalid_argument(std::string(name) + ": Size mismatch.");
+        }
+
+        inline void checkGrad(const char* name, ConstMatrixView y_pred, MatrixView grad) {
+            if (grad.rows != y_pred.rows || grad.cols != y_pred.cols)
+                throw std::invalid_argument(std::string(name) + ": Gradient shape mismatch.");
+        }
+
+        inline double clampProbability(double p) {
+            const double eps = 1e-7;
+            return (p < eps) ? eps : (p > 1.0 - eps) ? 1.0 - eps : p;
+        }
+    } // namespace detail
+
+    /**
+     * @brief Mean squared error: sum (y_pred - y_true)^2 / (2 N), N = rows * cols.
+     */
+    struct MSELoss {
+        double forwardBackward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkShapes("MSELoss", y_true, y_pred);
+            const bool with_grad = grad.data != nullptr;
+            if (with_grad) detail::checkGrad("MSELoss", y_pred, grad);
+
+            const double inv_n = 1.0 / (y_true.rows * y_true.cols);
+            double total = 0.0;
+            for (size_t i = 0; i < y_true.rows; ++i) {
+                const Scalar* t = y_true.row(i);
+                const Scalar* p = y_pred.row(i);
+                for (size_t j = 0; j < y_true.cols; ++j) {
+                    const double diff = p[j] - t[j];
+                    total += diff * diff;
+                    if (with_grad) grad(i, j) = static_cast<Scalar>(diff * inv_n);
+                }
+            }
+            return total * inv_n * 0.5;
+        }
+
+        double forward(ConstMatrixView y_true, ConstMatrixView y_pred) const {
+            return forwardBackward(y_true, y_pred, MatrixView());
+        }
+
+        void backward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkGrad("MSELoss", y_pred, grad);
+            forwardBackward(y_true, y_pred, grad);
+        }
+    };
+
+    /**
+     * @brief Mean absolute error: sum |y_pred - y_true| / N.
+     */
+    struct MAELoss {
+        double forwardBackward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkShapes("MAELoss", y_true, y_pred);
+            const bool with_grad = grad.data != nullptr;
+            if (with_grad) detail::checkGrad("MAELoss", y_pred, grad);
+
+            const double inv_n = 1.0 / (y_true.rows * y_true.cols);
+            double total = 0.0;
+            for (size_t i = 0; i < y_true.rows; ++i) {
+                const Scalar* t = y_true.row(i);
+                const Scalar* p = y_pred.row(i);
+                for (size_t j = 0; j < y_true.cols; ++j) {
+                    total += std::abs(p[j] - t[j]);
+                    if (with_grad) {
+                        const double sign = (p[j] > t[j]) ? 1.0 : (p[j] < t[j]) ? -1.0 : 0.0;
+                        grad(i, j) = static_cast<Scalar>(sign * inv_n);
+                    }
+                }
+            }
+            return total * inv_n;
+        }
+
+        double forward(ConstMatrixView y_true, ConstMatrixView y_pred) const {
+            return forwardBackward(y_true, y_pred, MatrixView());
+        }
+
+        void backward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkGrad("MAELoss", y_pred, grad);
+            forwardBackward(y_true, y_pred, grad);
+        }
+    };
+
+    /**
+     * @brief Binary cross entropy averaged over all elements.
+     *
+     * With from_logits the predictions are passed through a sigmoid and the
+     * gradient is (p - y) / N; otherwise (p - y) / (p (1 - p) N).
+     */
+    struct BCELoss {
+        bool from_logits = false;
+
+        explicit BCELoss(bool from_logits = false) : from_logits(from_logits) {}
+
+        double forwardBackward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkShapes("BCELoss", y_true, y_pred);
+            const bool with_grad = grad.data != nullptr;
+            if (with_grad) detail::checkGrad("BCELoss", y_pred, grad);
+
+            const double inv_n = 1.0 / (y_true.rows * y_true.cols);
+            double total = 0.0;
+            for (size_t i = 0; i < y_true.rows; ++i) {
+                const Scalar* t = y_true.row(i);
+                const Scalar* z = y_pred.row(i);
+                for (size_t j = 0; j < y_true.cols; ++j) {
+                    const double p = detail::clampProbability(from_logits ? FastMath::sigmoid(static_cast<double>(z[j])) : z[j]);
+                    total -= t[j] * FastMath::log(p) + (1.0 - t[j]) * FastMath::log(1.0 - p);
+                    if (with_grad) {
+                        const double g = from_logits ? (p - t[j]) : (p - t[j]) / (p * (1.0 - p));
+                        grad(i, j) = static_cast<Scalar>(g * inv_n);
+                    }
+                }
+            }
+            return total * inv_n;
+        }
+
+        double forward(ConstMatrixView y_true, ConstMatrixView y_pred) const {
+            return forwardBackward(y_true, y_pred, MatrixView());
+        }
+
+        void backward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkGrad("BCELoss", y_pred, grad);
+            forwardBackward(y_true, y_pred, grad);
+        }
+    };
+
+    /**
+     * @brief Categorical cross entropy averaged over rows.
+     *
+     * With from_logits this is the fused softmax_cross_entropy_batch kernel.
+     * On probabilities the gradient is (p - y) / rows, i.e. it assumes the
+     * softmax layer passes gradients through (see ActivationLayer).
+     */
+    struct CrossEntropyLoss {
+        bool from_logits = false;
+
+        explicit CrossEntropyLoss(bool from_logits = false) : from_logits(from_logits) {}
+
+        double forwardBackward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            if (from_logits) return softmax_cross_entropy_batch(y_pred, y_true, grad);
+
+            detail::checkShapes("CrossEntropyLoss", y_true, y_pred);
+            const bool with_grad = grad.data != nullptr;
+            if (with_grad) detail::checkGrad("CrossEntropyLoss", y_pred, grad);
+
+            const double inv_rows = 1.0 / y_true.rows;
+            double total = 0.0;
+            for (size_t i = 0; i < y_true.rows; ++i) {
+                const Scalar* t = y_true.row(i);
+                const Scalar* p = y_pred.row(i);
+                for (size_t j = 0; j < y_true.cols; ++j) {
+                    const double pc = detail::clampProbability(p[j]);
+                    total -= t[j] * FastMath::log(pc);
+                    if (with_grad) grad(i, j) = static_cast<Scalar>((pc - t[j]) * inv_rows);
+                }
+            }
+            return total * inv_rows;
+        }
+
+        double forward(ConstMatrixView y_true, ConstMatrixView y_pred) const {
+            return forwardBackward(y_true, y_pred, MatrixView());
+        }
+
+        void backward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkGrad("CrossEntropyLoss", y_pred, grad);
+            forwardBackward(y_true, y_pred, grad);
+        }
+    };
+
+    /**
+     * @brief Hinge loss averaged over all elements (targets in {-1, +1}).
+     */
+    struct HingeLoss {
+        double forwardBackward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkShapes("HingeLoss", y_true, y_pred);
+            const bool with_grad = grad.data != nullptr;
+            if (with_grad) detail::checkGrad("HingeLoss", y_pred, grad);
+
+            const double inv_n = 1.0 / (y_true.rows * y_true.cols);
+            double total = 0.0;
+            for (size_t i = 0; i < y_true.rows; ++i) {
+                const Scalar* t = y_true.row(i);
+                const Scalar* p = y_pred.row(i);
+                for (size_t j = 0; j < y_true.cols; ++j) {
+                    const double margin = 1.0 - t[j] * p[j];
+                    if (margin > 0.0) total += margin;
+                    if (with_grad) grad(i, j) = margin > 0.0 ? static_cast<Scalar>(-t[j] * inv_n) : Scalar(0);
+                }
+            }
+            return total * inv_n;
+        }
+
+        double forward(ConstMatrixView y_true, ConstMatrixView y_pred) const {
+            return forwardBackward(y_true, y_pred, MatrixView());
+        }
+
+        void backward(ConstMatrixView y_true, ConstMatrixView y_pred, MatrixView grad) const {
+            detail::checkGrad("HingeLoss", y_pred, grad);
+            forwardBackward(y_true, y_pred, grad);
+        }
+    };
+
+} // namespace Losses
@@ -1,6 +1,9 @@
 #pragma once 
 
 #include <vector>
+#include <cstddef>
+#include "../Utils/Precision.h"
+#include "../Utils/MatrixView.h"
 
 /**
  * @namespace Losses
@@ -16,7 +19,7 @@ namespace Losses {
      * @param y_pred Predicted vector.
      * @return Computed MSE loss.
      */
-    double mse_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred);
+    double mse_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred);
 
     /**
      * @brief Computes the derivative of MSE loss for a single sample.
@@ -24,7 +27,7 @@ namespace Losses {
      * @param y_pred Predicted vector.
      * @return Gradient vector.
      */
-    std::vector<double> mse_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred);
+    std::vector<Scalar> mse_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred);
 
     /**
      * @brief Computes the Mean Squared Error (MSE) loss for a batch of samples.
@@ -32,7 +35,7 @@ namespace Losses {
      * @param y_pred Predicted batch.
      * @return Computed batch MSE loss.
      */
-    double mse_loss_batch(const std::vector<std::vector<double>>& y_true, const std::vector<std::vector<double>>& y_pred);
+    double mse_loss_batch(const std::vector<std::vector<Scalar>>& y_true, const std::vector<std::vector<Scalar>>& y_pred);
 
     /**
      * @brief Computes the derivative of MSE loss for a batch of samples.
@@ -40,8 +43,8 @@ namespace Losses {
      * @param y_pred Predicted batch.
      * @return Gradient batch.
      */
-    std::vector<std::vector<double>> mse_derivative_batch(const std::vector<std::vector<double>>& y_true,
-                                                          const std::vector<std::vector<double>>& y_pred);
+    std::vector<std::vector<Scalar>> mse_derivative_batch(const std::vector<std::vector<Scalar>>& y_true,
+                                                          const std::vector<std::vector<Scalar>>& y_pred);
 
     // ----------------- Mean Absolute Error (MAE) -----------------
 
@@ -51,7 +54,7 @@ namespace Losses {
      * @param y_pred Predicted vector.
      * @return Computed MAE loss.
      */
-    double mae_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred);
+    double mae_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred);
 
     /**
      * @brief Computes the derivative of MAE loss for a single sample.
@@ -59,7 +62,7 @@ namespace Losses {
      * @param y_pred Predicted vector.
      * @return Gradient vector.
      */
-    std::vector<double> mae_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred);
+    std::vector<Scalar> mae_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred);
 
     /**
      * @brief Computes the Mean Absolute Error (MAE) loss for a batch of samples.
@@ -67,7 +70,7 @@ namespace Losses {
      * @param y_pred Predicted batch.
      * @return Computed batch MAE loss.
      */
-    double mae_loss_batch(const std::vector<std::vector<double>>& y_true, const std::vector<std::vector<double>>& y_pred);
+    double mae_loss_batch(const std::vector<std::vector<Scalar>>& y_true, const std::vector<std::vector<Scalar>>& y_pred);
 
     /**
      * @brief Computes the derivative of MAE loss for a batch of samples.
@@ -75,8 +78,8 @@ namespace Losses {
      * @param y_pred Predicted batch.
      * @return Gradient batch.
      */
-    std::vector<std::vector<double>> mae_derivative_batch(const std::vector<std::vector<double>>& y_true,
-                                                          const std::vector<std::vector<double>>& y_pred);
+    std::vector<std::vector<Scalar>> mae_derivative_batch(const std::vector<std::vector<Scalar>>& y_true,
+                                                          const std::vector<std::vector<Scalar>>& y_pred);
 
     // ----------------- Binary Cross Entropy (BCE) -----------------
 
@@ -90,7 +93,7 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits and need sigmoid activation.
      * @return Computed BCE loss.
      */
-    double bce_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred, bool from_logits = false);
+    double bce_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred, bool from_logits = false);
 
     /**
      * @brief Computes the derivative of BCE loss for a single sample.
@@ -102,7 +105,7 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits.
      * @return Gradient vector.
      */
-    std::vector<double> bce_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred, bool from_logits = false);
+    std::vector<Scalar> bce_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred, bool from_logits = false);
 
     /**
      * @brief Computes the Binary Cross Entropy (BCE) loss for a batch of samples.
@@ -114,7 +117,7 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits.
      * @return Computed batch BCE loss.
      */
-    double bce_loss_batch(const std::vector<std::vector<double>>& y_true, const std::vector<std::vector<double>>& y_pred, bool from_logits = false);
+    double bce_loss_batch(const std::vector<std::vector<Scalar>>& y_true, const std::vector<std::vector<Scalar>>& y_pred, bool from_logits = false);
 
     /**
      * @brief Computes the derivative of BCE loss for a batch of samples.
@@ -126,8 +129,8 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits.
      * @return Gradient batch.
      */
-    std::vector<std::vector<double>> bce_derivative_batch(const std::vector<std::vector<double>>& y_true,
-                                                          const std::vector<std::vector<double>>& y_pred,
+    std::vector<std::vector<Scalar>> bce_derivative_batch(const std::vector<std::vector<Scalar>>& y_true,
+                                                          const std::vector<std::vector<Scalar>>& y_pred,
                                                           bool from_logits = false);
 
     // ----------------- Cross Entropy -----------------
@@ -142,7 +145,7 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits and need softmax activation.
      * @return Computed Cross Entropy loss.
      */
-    double cross_entropy_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred, bool from_logits = false);
+    double cross_entropy_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred, bool from_logits = false);
 
     /**
      * @brief Computes the derivative of Cross Entropy loss for a single sample.
@@ -154,7 +157,7 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits.
      * @return Gradient vector.
      */
-    std::vector<double> cross_entropy_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred, bool from_logits = false);
+    std::vector<Scalar> cross_entropy_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred, bool from_logits = false);
 
     /**
      * @brief Computes the Cross Entropy loss for a batch of samples.
@@ -166,7 +169,7 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits.
      * @return Computed batch Cross Entropy loss.
      */
-    double cross_entropy_loss_batch(const std::vector<std::vector<double>>& y_true, const std::vector<std::vector<double>>& y_pred, bool from_logits = false);
+    double cross_entropy_loss_batch(const std::vector<std::vector<Scalar>>& y_true, const std::vector<std::vector<Scalar>>& y_pred, bool from_logits = false);
 
     /**
      * @brief Computes the derivative of Cross Entropy loss for a batch of samples.
@@ -178,10 +181,41 @@ namespace Losses {
      * @param from_logits Set true if predictions are logits.
      * @return Gradient batch.
      */
-    std::vector<std::vector<double>> cross_entropy_derivative_batch(const std::vector<std::vector<double>>& y_true,
-                                                                    const std::vector<std::vector<double>>& y_pred,
+    std::vector<std::vector<Scalar>> cross_entropy_derivative_batch(const std::vector<std::vector<Scalar>>& y_true,
+                                                                    const std::vector<std::vector<Scalar>>& y_pred,
                                                                     bool from_logits = false);
 
+    /**
+     * @brief Fused softmax + cross entropy over a contiguous batch of logits.
+     *
+     * One log-sum-exp pass per row gives both the loss and the gradient:
+     * loss_i = logsumexp(z_i) - sum_j y_ij z_ij, grad_ij = (softmax(z_i)_j - y_ij) / rows.
+     * No intermediate probability vectors are allocated; rows run in parallel on
+     * ThreadPool::global().
+     *
+     * @param logits Logits [rows x classes].
+     * @param y_true Target distributions [rows x classes] (one-hot or soft labels).
+     * @param grad Output gradient w.r.t. the logits [rows x classes], averaged over rows.
+     *             May alias logits; pass an empty MatrixView to compute the loss only.
+     * @return Mean cross entropy over the batch.
+     * @throws std::invalid_argument On shape mismatch or an empty batch.
+     */
+    double softmax_cross_entropy_batch(ConstMatrixView logits, ConstMatrixView y_true, MatrixView grad);
+
+    /**
+     * @brief Fused softmax + cross entropy with sparse class-index labels.
+     *
+     * Same as softmax_cross_entropy_batch with y_true one-hot at labels[i];
+     * avoids materialising one-hot targets.
+     *
+     * @param logits Logits [rows x classes].
+     * @param labels Class index of every row (labels.size() == rows, each < classes).
+     * @param grad Output gradient [rows x classes], averaged over rows. May alias logits or be empty.
+     * @return Mean cross entropy over the batch.
+     * @throws std::invalid_argument On shape mismatch, an empty batch or an out-of-range label.
+     */
+    double sparse_softmax_cross_entropy_batch(ConstMatrixView logits, const std::vector<size_t>& labels, MatrixView grad);
+
     // ----------------- Hinge Loss -----------------
 
     /**
@@ -190,7 +224,7 @@ namespace Losses {
      * @param y_pred Predicted vector.
      * @return Computed Hinge loss.
      */
-    double hinge_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred);
+    double hinge_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred);
 
     /**
      * @brief Computes the derivative of Hinge loss for a single sample.
@@ -198,7 +232,7 @@ namespace Losses {
      * @param y_pred Predicted vector.
      * @return Gradient vector.
      */
-    std::vector<double> hinge_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred);
+    std::vector<Scalar> hinge_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred);
 
     /**
      * @brief Computes the Hinge loss for a batch of samples.
@@ -206,7 +240,7 @@ namespace Losses {
      * @param y_pred Predicted batch.
      * @return Computed batch Hinge loss.
      */
-    double hinge_loss_batch(const std::vector<std::vector<double>>& y_true, const std::vector<std::vector<double>>& y_pred);
+    double hinge_loss_batch(const std::vector<std::vector<Scalar>>& y_true, const std::vector<std::vector<Scalar>>& y_pred);
 
     /**
      * @brief Computes the derivative of Hinge loss for a batch of samples.
@@ -214,7 +248,7 @@ namespace Losses {
      * @param y_pred Predicted batch.
      * @return Gradient batch.
      */
-    std::vector<std::vector<double>> hinge_derivative_batch(const std::vector<std::vector<double>>& y_true,
-                                                            const std::vector<std::vector<double>>& y_pred);
+    std::vector<std::vector<Scalar>> hinge_derivative_batch(const std::vector<std::vector<Scalar>>& y_true,
+                                                            const std::vector<std::vector<Scalar>>& y_pred);
 
 } // namespace Losses
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <cstddef>
+#include "../Utils/Precision.h"
+
+/**
+ * @file SampledSoftmax.h
+ * @brief Candidate samplers and the sampled softmax loss for very large output spaces.
+ *
+ * Instead of normalising over every class, each sample is scored against its
+ * true class plus num_sampled classes drawn from a proposal distribution Q.
+ * Subtracting log(num_sampled * Q(c)) from every candidate logit corrects for
+ * the proposal, so the sampled loss is a consistent estimate of the full
+ * softmax cross entropy. Paired with DenseLayer::forwardSampled /
+ * backwardSampled (or Sequential::trainSampled) the per-sample cost is
+ * O(num_sampled * hidden) instead of O(classes * hidden).
+ */
+namespace Losses {
+
+    /**
+     * @brief Draws negative classes from a log-uniform (Zipfian) or unigram distribution.
+     *
+     * Classes are sampled with replacement. The log-uniform proposal,
+     * Q(c) = log((c + 2) / (c + 1)) / log(classes + 1), suits class ids sorted
+     * by decreasing frequency; the unigram proposal uses Q(c) proportional to
+     * counts[c]^power and is sampled by binary search over its CDF.
+     */
+    class CandidateSampler {
+    public:
+        enum class Distribution {
+            LOG_UNIFORM, ///< Zipfian over class ids (most frequent class = 0)
+            UNIGRAM      ///< Proportional to counts^power
+        };
+
+        /**
+         * @brief Creates a log-uniform sampler.
+         * @param num_classes Size of the output space.
+         * @param seed RNG seed.
+         * @throws std::invalid_argument If num_classes is 0.
+         */
+        explicit CandidateSampler(size_t num_classes, unsigned int seed = 21);
+
+        /**
+         * @brief Creates a unigram sampler from class frequencies.
+         * @param counts Frequency of every class (positive: a zero-count class has Q(c) = 0,
+         *               so its logit correction would be infinite).
+         * @param power Distortion exponent (0.75 flattens the distribution as in word2vec).
+         * @param seed RNG seed.
+         * @throws std::invalid_argument If counts is empty or has an entry that is not positive.
+         */
+        CandidateSampler(const std::vector<double>& counts, double power = 0.75, unsigned int seed = 21);
+
+        /**
+         * @brief Draws num_sampled classes (with replacement) into out.
+         */
+        void sample(size_t num_sampled, std::vector<size_t>& out);
+
+        /**
+         * @brief Proposal probability Q(c).
+         */
+        double probability(size_t c) const;
+
+        /**
+         * @brief log(num_sampled * Q(c)), the logit correction for class c.
+         */
+        double logExpectedCount(size_t c, size_t num_sampled) const;
+
+        size_t numClasses() const { return num_classes; }
+        Distribution getDistribution() const { return distribution; }
+
+    private:
+        Distribution distribution;
+        size_t num_classes;
+        double log_range = 0.0;            ///< log(num_classes + 1) (log-uniform)
+        std::vector<double> cdf;           ///< Cumulative unnormalised weights (unigram)
+        std::mt19937 rng;
+        std::uniform_real_distribution<double> uniform{0.0, 1.0};
+    };
+
+    /**
+     * @brief Sampled softmax cross entropy for one sample.
+     *
+     * candidates[0] is the true class, candidates[1..] the sampled classes;
+     * logits[k] is the raw logit of candidates[k]. With the corrected logits
+     * z'_k = logits[k] - log(num_sampled Q(candidates[k])) the loss is
+     * logsumexp(z') - z'_0 and grad[k] = softmax(z')_k - [k == 0]. Sampled
+     * candidates equal to the true class ("accidental hits") are excluded and
+     * get a zero gradient when remove_accidental_hits is set.
+     *
+     * @param logits Raw logits of the candidates [num_candidates].
+     * @param candidates Class ids [num_candidates], true class first.
+     * @param num_candidates 1 + number of sampled classes.
+     * @param sampler Sampler that produced the candidates (for the correction).
+     * @param grad Output gradient w.r.t. logits [num_candidates] (may alias logits, or nullptr).
+     * @param remove_accidental_hits Mask sampled copies of the true class.
+     * @return Loss of this sample.
+     * @throws std::invalid_argument If num_candidates < 2.
+     */
+    double sampled_softmax_loss(const Scalar* logits, const size_t* candidates, size_t num_candidates,
+                                const CandidateSampler& sampler, Scalar* grad,
+                                bool remove_accidental_hits = true);
+
+    /**
+     * @brief Same, with a caller-owned buffer for the corrected logits.
+     *
+     * corrected is resized to num_candidates and holds z' on return; reusing
+     * it across samples keeps the loss free of heap allocations.
+     */
+    double sampled_softmax_loss(const Scalar* logits, const size_t* candidates, size_t num_candidates,
+                                const CandidateSampler& sampler, Scalar* grad,
+                                std::vector<double>& corrected, bool remove_accidental_hits = true);
+
+} // namespace Losses
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Models/Sequential.h"
+
+/**
+ * @brief INT8 post-training quantized, inference-only version of a Sequential model.
+ *
+ * Built from a trained Sequential model and a calibration dataset:
+ * - Dense weights are quantized symmetrically to int8 with one scale per
+ *   output channel (row); biases to int32 in the accumulator scale.
+ * - The input range of every Dense layer is calibrated (max |x|) on the
+ *   calibration samples and used as a per-tensor activation scale.
+ * - Inference runs int8 x int8 -> int32 dot products. A following ReLU,
+ *   Leaky ReLU or Linear activation is fused into the requantisation of the
+ *   accumulator back to int8 for the next Dense layer.
+ * - Other activations (Sigmoid, Tanh, SELU, Softmax) run in floating point
+ *   between dequantisation and the next layer's quantisation.
+ *
+ * The last Dense layer dequantizes its output, so forward() returns the
+ * same kind of values (logits / regression outputs) as the float model.
+ */
+class QuantizedSequential {
+private:
+    /**
+     * @brief One quantized Dense layer with an optional fused activation.
+     */
+    struct QuantizedDense {
+        size_t input_size = 0;
+        size_t output_size = 0;
+        std::vector<int8_t> weights;             ///< Row-major [output_size x input_size]
+        std::vector<float> weight_scales;        ///< Per output channel
+        std::vector<int32_t> biases;             ///< Quantized with input_scale * weight_scale
+        float input_scale = 1.0f;                ///< Real value of one input quantization step
+        float output_scale = 0.0f;               ///< Requantisation scale (int8 output only)
+        std::vector<float> output_multipliers;   ///< input_scale * weight_scale (per channel)
+        ActivationType fused_activation = ActivationType::LINEAR;
+        double alpha = 0.01;                     ///< Leaky ReLU slope
+        bool int8_output = false;                ///< Requantize (true) or dequantize (false)
+    };
+
+    /**
+     * @brief Pipeline stage: a quantized Dense layer or a float activation.
+     */
+    struct Stage {
+        bool is_dense = true;
+        QuantizedDense dense;
+        ActivationType activation = ActivationType::LINEAR;
+        double alpha = 0.01;
+        double lambda = 1.0507;
+    };
+
+    std::vector<Stage> stages;
+    size_t input_size = 0;
+
+    /**
+     * @brief Quantizes a Dense layer's weights and biases per output channel.
+     */
+    static QuantizedDense quantizeDense(const DenseLayer& layer, float input_scale);
+
+    /**
+     * @brief Runs one quantized Dense layer on an int8 input.
+     * @param layer Quantized layer.
+     * @param input Quantized input (input_size).
+     * @param out_q Output when layer.int8_output is true.
+     * @param out_f Output when layer.int8_output is false.
+     */
+    static void denseKernel(const QuantizedDense& layer, const int8_t* input,
+                            std::vector<int8_t>& out_q, std::vector<Scalar>& out_f);
+
+public:
+    /**
+     * @brief Calibrates on sample data and quantizes a trained model.
+     * @param model Trained float model (only Dense and Activation layers are supported).
+     * @param calibration Representative input samples.
+     * @param max_samples Maximum number of calibration rows to use (default 1000).
+     * @throws std::invalid_argument If the model has no Dense layers, contains an
+     *         unsupported layer or the calibration set is empty / mis-sized.
+     */
+    QuantizedSequential(Sequential& model, const Dataset& calibration, size_t max_samples = 1000);
+
+    /**
+     * @brief Runs integer inference on a single sample.
+     *
+     * const and re-entrant: uses only local buffers, so several threads may
+     * run inference on the same quantized model concurrently.
+     *
+     * @param input Input vector (input_size).
+     * @return Dequantized output of the last layer.
+     */
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) const;
+
+    /**
+     * @brief Size in bytes of the quantized parameters (weights, scales, biases).
+     */
+    size_t getParameterBytes() const;
+
+    /**
+     * @brief Prints the quantized pipeline.
+     */
+    void summary() const;
+};
@@ -4,9 +4,15 @@
 #include <memory>
 #include <stdexcept>
 #include <functional> 
+#include <atomic>
+#include <algorithm>
 #include "Data/DataLoader.h"
 #include "Layers/Layers.h"
 #include "Optimizers/SGD.h"
+#include "Utils/MatrixView.h"
+#include "Metrics/SampledSoftmax.h"
+#include "Utils/Reduction.h"
+#include "Utils/Atomics.h"
 
 #define MANUAL_SEED 21
 
@@ -33,6 +39,247 @@ private:
      */
     bool is_initialized = false;
 
+    /**
+     * @brief Dynamic loss-scaling state (mixed-precision training).
+     *
+     * The loss gradient is multiplied by loss_scale before backward; before
+     * the optimizer step gradients are unscaled. A step whose gradients
+     * overflowed is skipped and the scale halved; after
+     * loss_scale_growth_interval clean steps the scale is doubled.
+     */
+    bool loss_scaling_enabled = false;
+    bool dynamic_loss_scaling = true;
+    double loss_scale = 1.0;
+    size_t loss_scale_growth_interval = 2000;
+    size_t loss_scale_good_steps = 0;
+
+    /**
+     * @brief Per-shard state of data-parallel training.
+     *
+     * Shard 0 runs on this model's own layers; shard s > 0 runs on `layers`, a
+     * clone of the layer stack with its own activation caches and gradient
+     * buffers. Buffers are reused across batches and epochs.
+     */
+    struct Worker {
+        std::vector<std::unique_ptr<BaseLayer>> layers; ///< Replica stack (empty for shard 0)
+        ParameterRegistry parameters;                   ///< Parameter spans of the replica stack
+        std::vector<Scalar> flat_values;                ///< Replica parameters when flattened
+        std::vector<Scalar> flat_grads;                 ///< Replica gradients when flattened
+        std::vector<Scalar> buffer;                     ///< Activations forward, gradients backward
+        std::vector<Scalar> loss_grad;                  ///< Loss gradient of the current sample
+        std::vector<std::vector<Scalar>> velocity;      ///< Worker-local momentum (trainAsync)
+        std::vector<uint32_t> seen_versions;            ///< Block versions last copied from the shared weights (trainAsync)
+        std::vector<Scalar> arena;                      ///< Activation arena of the compiled plan
+        std::vector<std::vector<Scalar>> checkpoints;   ///< Stored inputs of the recomputed segments
+        std::vector<Scalar> scratch;                    ///< Cache-free forward / segment recomputation
+        CachePool cache_pool;                           ///< Cache buffers passed between recomputed segments
+        Reduction::CompensatedSum loss;                 ///< Loss of the shard's samples
+    };
+
+    size_t data_parallel_replicas = 1;  ///< Shards per batch (1 = serial)
+    size_t micro_batch_size = 0;        ///< Samples per micro-batch in train() (0 = whole batch)
+    std::vector<size_t> checkpoints;    ///< First layer of every checkpointed segment (empty = off)
+    std::vector<Worker> workers;
+    std::vector<uint32_t> async_versions; ///< Write counter per SGD::stepAsync block (trainAsync)
+
+    ParameterRegistry parameters;       ///< Parameter spans of this->layers (see registerParameters)
+
+    bool flat_parameters = false;       ///< Set by flattenParameters()
+    std::vector<Scalar> flat_values;    ///< All layer parameters, in layer order
+    std::vector<Scalar> flat_grads;     ///< All layer gradients, same layout
+
+    /**
+     * @brief Rebuilds the parameter registry from the current layers.
+     *
+     * Called once at the start of every training call, so layers may be
+     * replaced or re-initialised between calls; the per-batch gradient
+     * zeroing, loss-scaling checks and optimizer steps then walk the table.
+     * With flattenParameters() on, layers replaced since the last build are
+     * packed into fresh flat buffers first.
+     */
+    void registerParameters();
+
+    /**
+     * @brief Binds every layer of a stack to consecutive ranges of new flat buffers.
+     *
+     * Current values and gradients are copied over, then registry is rebuilt
+     * over the new buffers.
+     *
+     * @throws std::logic_error If a layer registers parameters but cannot bind them.
+     */
+    static void packParameters(const std::vector<std::unique_ptr<BaseLayer>>& stack,
+                               ParameterRegistry& registry,
+                               std::vector<Scalar>& values,
+                               std::vector<Scalar>& grads);
+
+    /**
+     * @brief Shapes and buffer assignment produced by compile().
+     *
+     * widths[i] is the width of activation i (the input of layer i; the last
+     * entry is the model output). In a chain only a layer's input and output
+     * are alive at the same time, so two arena regions are enough: every
+     * non-element-wise layer writes to the region its input is not in, and
+     * element-wise layers run in place. slots[i] is the region holding
+     * activation i in the forward pass and its gradient in the backward pass.
+     */
+    struct ExecutionPlan {
+        bool compiled = false;
+        std::vector<size_t> widths;
+        std::vector<size_t> slots;
+        size_t region_size = 0;     ///< Scalars per region (widest activation)
+    };
+
+    ExecutionPlan plan;
+    mutable std::vector<Scalar> arena;  ///< Arena used by forward()/backward() once compiled
+
+    /**
+     * @brief Runs a layer stack forward through the plan.
+     * @param stack This model's layers or a worker replica.
+     * @param arena_data Arena of 2 * plan.region_size Scalars.
+     * @param input Input [plan.widths[0]] (outside the arena).
+     * @param input_size Width of the input (validated).
+     * @return Pointer to the output inside the arena.
+     */
+    const Scalar* runForward(const std::vector<std::unique_ptr<BaseLayer>>& stack, Scalar* arena_data,
+                             const Scalar* input, size_t input_size) const;
+
+    /**
+     * @brief Runs a layer stack backward through the plan.
+     *
+     * The output gradient must already be in outputGradient(arena_data).
+     *
+     * @return Pointer to the gradient w.r.t. the input inside the arena.
+     */
+    const Scalar* runBackward(const std::vector<std::unique_ptr<BaseLayer>>& stack, Scalar* arena_data) const;
+
+    /**
+     * @brief Arena location of the model output (and of its gradient).
+     */
+    Scalar* outputSlot(Scalar* arena_data) const {
+        return arena_data + plan.slots.back() * plan.region_size;
+    }
+
+    /**
+     * @brief Forward pass of one sample on a layer stack; the output is left in worker.buffer.
+     *
+     * Uses forwardCheckpointed() when setCheckpoints() is on, else the
+     * compiled plan and the worker's arena when available, otherwise the
+     * layers' in-place passes.
+     */
+    void forwardStack(const std::vector<std::unique_ptr<BaseLayer>>& stack, const std::vector<Scalar>& x,
+                      Worker& worker) const;
+
+    /**
+     * @brief Backward pass of one sample on a layer stack.
+     * @param grad Gradient w.r.t. the output; used as scratch (contents are overwritten).
+     */
+    void backwardStack(const std::vector<std::unique_ptr<BaseLayer>>& stack, std::vector<Scalar>& grad,
+                       Worker& worker) const;
+
+    /**
+     * @brief forwardStack with checkpointing: only segment inputs are kept.
+     *
+     * Every segment but the last runs cache-free and stores its input in
+     * worker.checkpoints; the last segment caches as usual, since its
+     * backward pass comes first.
+     */
+    void forwardCheckpointed(const std::vector<std::unique_ptr<BaseLayer>>& stack, const std::vector<Scalar>& x,
+                             Worker& worker) const;
+
+    /**
+     * @brief backwardStack with checkpointing, segment by segment from the output.
+     *
+     * Each earlier segment is first re-run forward from its stored input to
+     * rebuild its caches in buffers taken from worker.cache_pool, and gives
+     * them back after its backward pass. The last segment keeps its caches
+     * for the next sample's forward pass.
+     */
+    void backwardCheckpointed(const std::vector<std::unique_ptr<BaseLayer>>& stack, std::vector<Scalar>& grad,
+                              Worker& worker) const;
+
+    /**
+     * @brief Clones the layer stack into worker.layers unless it already matches.
+     *
+     * A replica matches when it has as many layers and parameters as the
+     * registry built by registerParameters().
+     */
+    void buildReplica(Worker& worker);
+
+    /**
+     * @brief Prepares the workers for one batch and returns the number of shards.
+     *
+     * Creates the replicas on first use (or after the layer stack changed),
+     * copies the current parameters into them and clears their gradients, in
+     * parallel over the replicas.
+     *
+     * @param batch_size Samples per runShards() call: the batch, or its micro-batch
+     *                   (never split into more shards than samples).
+     */
+    size_t prepareWorkers(size_t batch_size);
+
+    /**
+     * @brief Copies the shared weights into a trainAsync worker's replica.
+     *
+     * Works in the SGD::stepAsync blocks: a block is copied (relaxed atomic
+     * loads) when its entry in async_versions differs from the one the worker
+     * saw last, or always when changed_only is false. parametersChanged() is
+     * called only on layers with a refreshed block.
+     *
+     * @param worker Worker whose replica and seen_versions are updated.
+     * @param changed_only Skip blocks nobody has written since the last refresh.
+     */
+    void refreshReplica(Worker& worker, bool changed_only);
+
+    /**
+     * @brief Adds the replica gradients of shards 1..shards-1 into this model's layers.
+     */
+    void reduceWorkerGradients(size_t shards);
+
+    /**
+     * @brief Runs sample_fn over a batch split into contiguous shards, one per worker.
+     *
+     * Shards run concurrently on ThreadPool::global(); sample k goes to shard
+     * floor(k * shards / count). Each shard's losses are summed in sample order
+     * and the shard totals in shard order, so the result only depends on the
+     * shard count, not on thread scheduling.
+     *
+     * @param count Number of samples in the batch.
+     * @param shards Value returned by prepareWorkers().
+     * @param sample_fn Callable double(layer stack&, size_t k, Worker&) returning the sample's loss.
+     * @return Sum of the per-sample losses.
+     */
+    template <typename SampleFn>
+    double runShards(size_t count, size_t shards, SampleFn&& sample_fn);
+
+    /**
+     * @brief Micro-batch size used for a batch of batch_size samples.
+     */
+    size_t microBatchSize(size_t batch_size) const {
+        return micro_batch_size == 0 ? batch_size : std::min(micro_batch_size, batch_size);
+    }
+
+    /**
+     * @brief Forward, loss and backward of one sample on a layer stack.
+     *
+     * The loss gradient is multiplied by grad_scale before back-propagation
+     * and accumulates into the stack's gradient buffers.
+     *
+     * @return The sample's loss.
+     */
+    template <typename Loss>
+    double trainSample(std::vector<std::unique_ptr<BaseLayer>>& stack,
+                       const std::vector<Scalar>& x, const std::vector<Scalar>& y_true,
+                       const Loss& loss, Scalar grad_scale, Worker& worker);
+
+    /**
+     * @brief Unscales gradients and runs the optimizer step (skipped on overflow).
+     * @param optimizer Optimizer to step.
+     * @param batch_size Number of samples accumulated in the gradients.
+     * @param step_parameters Parameters to check, unscale and update: the
+     *        registry, or a subset of it (trainSampled's touched output rows).
+     */
+    void optimizerStep(BaseOptim& optimizer, size_t batch_size, const ParameterRegistry& step_parameters);
+
     /**
      * @brief Base case for recursive unpacking of variadic template arguments.
      * 
@@ -93,12 +340,147 @@ public:
                             double a = 0, double b = 1.0, 
                             double sparsity = 0.0, double bias_value = 0.1);
 
+    /**
+     * @brief Weight initialization used for a dense layer followed by the given activation.
+     */
+    static InitMethod initMethodFor(ActivationType act_type);
+
+    /**
+     * @brief Fuses every Dense layer directly followed by an element-wise
+     *        activation into a single DenseActivationLayer.
+     *
+     * Removes the activation layer's separate input copy and result allocation
+     * and applies the activation in the dense layer's epilogue. Parameters and
+     * storage precision are preserved, so it can be called before or after
+     * initializeParameters(). Softmax layers are left unfused.
+     *
+     * @return Number of layer pairs fused.
+     */
+    size_t fuseLayers();
+
+    /**
+     * @brief Compiles an execution plan with a preallocated activation arena.
+     *
+     * Walks the layers from input_size, infers every activation and gradient
+     * width (BaseLayer::outputSize) and assigns them to two regions of one
+     * arena, reused by liveness: a layer's input region is free again once
+     * its output is written, and element-wise layers run in place. The arena
+     * is allocated once; afterwards forwardCompiled() and the per-sample
+     * passes of train()/trainAsync() run without heap allocations, and
+     * forward()/backward() only allocate their returned vector. fuseLayers()
+     * recompiles automatically.
+     *
+     * @param input_size Width of the model input.
+     * @throws std::invalid_argument If a layer does not accept the inferred width.
+     * @throws std::logic_error If the model has no layers.
+     */
+    void compile(size_t input_size);
+
+    /**
+     * @brief Whether compile() has been called.
+     */
+    bool isCompiled() const {
+        return plan.compiled;
+    }
+
+    /**
+     * @brief Forward pass through the compiled plan, without heap allocation.
+     * @param input Input vector (size: compiled input width).
+     * @return 1 x output-width view into the arena, valid until the next forward/backward call.
+     * @throws std::logic_error If the model is not compiled.
+     */
+    ConstMatrixView forwardCompiled(const std::vector<Scalar>& input) const;
+
     /**
      * @brief Perform forward pass through all layers.
+     *
+     * Layers cache what backward() needs, so this is the training-time pass;
+     * use predict() for inference.
+     *
      * @param input Input vector.
      * @return Output vector after processing through all layers.
      */
-    std::vector<double> forward(const std::vector<double>& input) const;
+    std::vector<Scalar> forward(const std::vector<Scalar>& input) const;
+
+    /**
+     * @brief Width of the model output for an input of the given width.
+     * @throws std::invalid_argument If a layer does not accept the inferred width.
+     */
+    size_t outputSize(size_t input_size) const;
+
+    /**
+     * @brief Inference-only forward pass: no layer cache is written.
+     *
+     * Layers are only read and every intermediate activation lives in local
+     * buffers, so several threads may call predict() on the same model
+     * concurrently (as long as none of them trains or modifies it).
+     *
+     * @param input Input vector.
+     * @return Output vector.
+     */
+    std::vector<Scalar> predict(const std::vector<Scalar>& input) const;
+
+    /**
+     * @brief predict() between caller-owned buffers.
+     *
+     * Intermediate activations ping-pong between two regions of scratch, as in
+     * the compiled plan, and the last layer writes straight into output. Each
+     * thread passes its own scratch; once it has grown, calls do not allocate.
+     *
+     * @param input Input [input_size].
+     * @param input_size Width of the input.
+     * @param output Output [outputSize(input_size)].
+     * @param scratch Per-caller working memory, resized as needed.
+     */
+    void predictInto(const Scalar* input, size_t input_size, Scalar* output,
+                     std::vector<Scalar>& scratch) const;
+
+    /**
+     * @brief Batched inference over a whole dataset into a row-major output matrix.
+     *
+     * Rows are split across ThreadPool::global(); each chunk runs predictInto
+     * with its own scratch. Results do not depend on the thread count.
+     *
+     * @param X Input rows.
+     * @param output [X.rows() x outputSize(X.cols())] view to fill.
+     * @throws std::invalid_argument On shape mismatch.
+     */
+    void predictInto(const Dataset& X, MatrixView output) const;
+
+    /**
+     * @brief Batched inference over a whole dataset.
+     * @param X Input rows.
+     * @return One output row per input row (raw model outputs, e.g. logits).
+     */
+    Dataset predict(const Dataset& X) const;
+
+    /**
+     * @brief Result of evaluate().
+     */
+    struct Evaluation {
+        double loss = 0.0;                  ///< Mean loss over the dataset
+        double accuracy = 0.0;              ///< Fraction of rows whose predicted class matches the target
+        std::vector<size_t> predictions;    ///< Predicted class of every row
+    };
+
+    /**
+     * @brief Batched, multi-threaded evaluation of loss and accuracy.
+     *
+     * Runs predictInto(X, ...) once, then scores rows in parallel: every loss
+     * object is a mean of independent row terms, so the per-row losses are
+     * combined with Reduction::sum and the result is deterministic. The
+     * predicted class is the argmax of the output row; single-output models
+     * are scored as binary classifiers (output > 0.5, i.e. probabilities).
+     *
+     * @tparam Loss Loss object type (see Metrics/LossFunctions.h).
+     * @param X Input rows.
+     * @param y Targets (one-hot rows for classification).
+     * @param loss Loss object matching the model output (e.g. CrossEntropyLoss(true) for logits).
+     * @return Mean loss, accuracy and per-row predicted classes.
+     * @throws std::invalid_argument On empty or mismatched datasets.
+     */
+    template <typename Loss>
+    Evaluation evaluate(const Dataset& X, const Dataset& y, const Loss& loss) const;
 
     /**
      * @brief Perform backward pass through all layers.
@@ -106,7 +488,7 @@ public:
      * @param lr Learning rate (unused in backward pass).
      * @return Gradient with respect to the input.
      */
-    std::vector<double> backward(const std::vector<double>& grad_output);
+    std::vector<Scalar> backward(const std::vector<Scalar>& grad_output);
 
     /**
      * @brief Print summary of all layers.
@@ -128,17 +510,17 @@ public:
      * @param optimizer Optimizer to use for weight updates.
      * @param batch_size Size of each training batch.
      * @param loss_fn Loss function (y_true, y_pred) -> double.
-     * @param grad_fn Gradient function (y_true, y_pred) -> vector<double>.
+     * @param grad_fn Gradient function (y_true, y_pred) -> vector<Scalar>.
      * @return Total loss over the training set.
      */
     double train(                // function overload for single example loss 
         const Dataset& X_train,
         const Dataset& y_train,
         BaseOptim& optimizer,
-        std::function<double(const std::vector<double>&, 
-                             const std::vector<double>&)> loss_fn,
-        std::function<std::vector<double>(const std::vector<double>&, 
-                                          const std::vector<double>&)> grad_fn,
+        std::function<double(const std::vector<Scalar>&, 
+                             const std::vector<Scalar>&)> loss_fn,
+        std::function<std::vector<Scalar>(const std::vector<Scalar>&, 
+                                          const std::vector<Scalar>&)> grad_fn,
         unsigned int seed = MANUAL_SEED
     );
     
@@ -149,24 +531,279 @@ public:
      * @param optimizer Optimizer to use for weight updates.
      * @param batch_size Size of each training batch.
      * @param loss_fn Batch Loss function (y_true, y_pred) -> double.
-     * @param grad_fn Batch Gradient function (y_true, y_pred) -> vector<double>.
+     * @param grad_fn Batch Gradient function (y_true, y_pred) -> vector<Scalar>.
      * @return Total loss over the training set.
      */
     double train(                 // function overload for batch loss 
         const Dataset& X_train,
         const Dataset& y_train,
         BaseOptim& optimizer,
-        std::function<double(const std::vector<std::vector<double>>&, 
-                            const std::vector<std::vector<double>>&)> batch_loss_fn,
-        std::function<std::vector<std::vector<double>>(const std::vector<std::vector<double>>&, 
-                                                    const std::vector<std::vector<double>>&)> batch_grad_fn,
+        std::function<double(const std::vector<std::vector<Scalar>>&, 
+                            const std::vector<std::vector<Scalar>>&)> batch_loss_fn,
+        std::function<std::vector<std::vector<Scalar>>(const std::vector<std::vector<Scalar>>&, 
+                                                    const std::vector<std::vector<Scalar>>&)> batch_grad_fn,
         unsigned int seed = MANUAL_SEED
     );
 
+    /**
+     * @brief Performs one training pass over the dataset with a loss object.
+     *
+     * Templated on the loss type (see Metrics/LossFunctions.h), so the loss
+     * calls inline and nothing is type-erased. Each sample is run forward,
+     * its row of the batch loss is evaluated on one-row spans into a reused
+     * gradient buffer, scaled by 1 / batch size and propagated backward
+     * immediately; the forward/backward buffers belong to the workers and are
+     * reused across calls. Batches are split into micro-batches by
+     * setMicroBatchSize() and sharded when setDataParallel() is on.
+     *
+     * @tparam Loss Type providing forwardBackward(ConstMatrixView, ConstMatrixView, MatrixView) -> double.
+     * @param X_train Input features dataset.
+     * @param y_train Target dataset (one row per sample).
+     * @param optimizer Optimizer to use for weight updates.
+     * @param loss Loss object, e.g. Losses::CrossEntropyLoss(true).
+     * @param seed Shuffle seed.
+     * @return Mean loss over the training set.
+     */
+    template <typename Loss>
+    double train(
+        const Dataset& X_train,
+        const Dataset& y_train,
+        BaseOptim& optimizer,
+        const Loss& loss,
+        unsigned int seed = MANUAL_SEED
+    );
+
+    /**
+     * @brief Performs one asynchronous (Hogwild) training pass over the dataset.
+     *
+     * num_workers threads claim mini-batches of one shuffled epoch through an
+     * atomic counter. Each worker copies the shared weights into its own
+     * replica of the layer stack once, accumulates every batch gradient there
+     * and applies it straight to the shared weights with SGD::stepAsync:
+     * relaxed atomic loads/stores, no locks and no gradient reduction, so
+     * updates of the same weight may occasionally be lost. Only non-zero
+     * steps are written, and before each batch a worker re-copies only the
+     * 64-value blocks whose version counter another write has bumped (see
+     * refreshReplica), so sparse batches neither store nor reload the
+     * untouched weights. Suited to wide models whose batches touch mostly
+     * disjoint weights. The
+     * result is not deterministic. Momentum is kept per worker; the
+     * learning-rate scheduler advances once per batch after the pass.
+     *
+     * @tparam Loss Loss object type (see Metrics/LossFunctions.h).
+     * @param X_train Input features dataset.
+     * @param y_train Target dataset (one row per sample).
+     * @param optimizer SGD optimizer providing learning rate, momentum and clipping.
+     * @param loss Loss object.
+     * @param num_workers Worker threads (0 = ThreadPool::global().size()).
+     * @param seed Shuffle seed.
+     * @return Mean loss over the training set.
+     * @throws std::logic_error If loss scaling is enabled (overflow skipping needs a synchronous step).
+     */
+    template <typename Loss>
+    double trainAsync(
+        const Dataset& X_train,
+        const Dataset& y_train,
+        SGD& optimizer,
+        const Loss& loss,
+        size_t num_workers = 0,
+        unsigned int seed = MANUAL_SEED
+    );
+
+    /**
+     * @brief Sets the storage format of weight copies and cached activations in all Dense layers.
+     *
+     * BF16/FP16 halve the activation and weight traffic of forward/backward;
+     * optimizers keep updating the Scalar master weights.
+     *
+     * @param precision NATIVE, BF16 or FP16.
+     */
+    void setStoragePrecision(StoragePrecision precision);
+
+    /**
+     * @brief Trains a classifier with a very large output layer using sampled softmax.
+     *
+     * The last layer must be a plain DenseLayer producing raw logits. Once per
+     * batch num_sampled negative classes are drawn from the sampler; every
+     * sample then evaluates only its true class and those negatives through
+     * DenseLayer::forwardSampled, takes Losses::sampled_softmax_loss and
+     * scatters the gradient back with backwardSampled. Per-sample cost of the
+     * output layer scales with num_sampled rather than the number of classes.
+     *
+     * The per-batch gradient zeroing and optimizer step cover the other layers
+     * fully but only the output rows the batch touched (the negatives and the
+     * true classes, ParameterRegistry::addRows), and with BF16/FP16 storage
+     * only those rows are re-encoded, so the batch cost does not grow with the
+     * number of classes either. The updates are lazy: rows outside a batch
+     * keep their values and optimizer state, so momentum and adaptive moments
+     * of a row only advance in batches that touch it (plain SGD is
+     * unaffected). LARS and LAMB take their trust ratios over the touched rows.
+     *
+     * @param X_train Input features dataset.
+     * @param labels Class index of every training row.
+     * @param optimizer Optimizer to use for weight updates.
+     * @param sampler Proposal distribution over the output classes.
+     * @param num_sampled Number of negative classes per batch.
+     * @param seed Shuffle seed.
+     * @return Mean sampled loss over the training set.
+     * @throws std::invalid_argument On size mismatch or if the last layer is not a plain DenseLayer.
+     */
+    double trainSampled(
+        const Dataset& X_train,
+        const std::vector<size_t>& labels,
+        BaseOptim& optimizer,
+        Losses::CandidateSampler& sampler,
+        size_t num_sampled,
+        unsigned int seed = MANUAL_SEED
+    );
+
+    /**
+     * @brief Enables data-parallel training in train().
+     *
+     * Every mini-batch is split into num_replicas contiguous shards that run
+     * concurrently on ThreadPool::global(). Each shard owns a replica of the
+     * layer stack (separate activation caches and gradient buffers) that is
+     * refreshed from this model's parameters before the batch; afterwards the
+     * replica gradients are summed into this model's layers and a single
+     * optimizer step is taken. The result depends only on num_replicas (the
+     * summation order is fixed), not on thread timing. Applies to all train()
+     * overloads; trainSampled() stays serial. Loss and gradient callbacks of
+     * the std::function overloads must be safe to call concurrently.
+     *
+     * @param num_replicas Shards per batch (0 = ThreadPool::global().size(), 1 = serial).
+     */
+    void setDataParallel(size_t num_replicas = 0);
+
+    /**
+     * @brief Number of shards each batch is split into (1 = serial training).
+     */
+    size_t getDataParallel() const {
+        return data_parallel_replicas;
+    }
+
+    /**
+     * @brief Splits every mini-batch of train() into micro-batches.
+     *
+     * The optimizer's batch size keeps its meaning: gradients of all
+     * micro-batches of a batch accumulate in the layers (and in the replicas,
+     * which are reduced once per batch), followed by a single optimizer step
+     * normalised by the full batch. Per-batch buffers of the batch-loss
+     * overload (predictions, labels, gradients) then scale with the
+     * micro-batch, so the effective batch is no longer bounded by memory, and
+     * with setDataParallel() each micro-batch is sharded separately. With
+     * serial training the per-sample Loss / function overloads produce
+     * bit-identical gradients for any micro-batch size. The batch-loss
+     * overload assumes batch_grad_fn averages over its rows (as the
+     * Losses::*_batch functions do) and rescales each micro-batch by
+     * micro / batch, so it agrees with an unsplit batch only to rounding.
+     * trainAsync() and trainSampled() ignore the setting.
+     *
+     * @param micro_batch_size Samples per micro-batch (0 = whole batch).
+     */
+    void setMicroBatchSize(size_t micro_batch_size) {
+        this->micro_batch_size = micro_batch_size;
+    }
+
+    /**
+     * @brief Samples per micro-batch (0 = whole batch).
+     */
+    size_t getMicroBatchSize() const {
+        return micro_batch_size;
+    }
+
+    /**
+     * @brief Enables activation checkpointing (recomputation) in training.
+     *
+     * The layers are cut into segments that start at the given indices. In
+     * the forward pass of a sample only the input of every segment is kept;
+     * the layers of all segments but the last run cache-free. During backward
+     * each earlier segment is re-run forward from its stored input to
+     * rebuild its caches, back-propagated, and its cache buffers are handed
+     * to the next segment through a per-replica CachePool; the last segment
+     * keeps its caches. At most two segments' caches exist at a time, so the
+     * per-replica activation memory drops from the sum of all layer widths to
+     * the stored segment inputs plus two segments, for roughly one extra
+     * forward pass and no allocation once the buffers have grown. A segment
+     * every sqrt(layers) layers minimises the peak. Gradients are
+     * bit-identical.
+     *
+     * Applies to train() and trainAsync() (the compiled plan is bypassed),
+     * not to trainSampled() or to forward() / backward() called directly.
+     * fuseLayers() renumbers the layers and therefore clears the setting.
+     *
+     * @param boundaries Indices of the layers that start a segment (0 is implied);
+     *                   empty disables checkpointing.
+     * @throws std::out_of_range If an index is not smaller than the number of layers.
+     */
+    void setCheckpoints(std::vector<size_t> boundaries);
+
+    /**
+     * @brief First layer of every checkpointed segment (empty when disabled).
+     */
+    const std::vector<size_t>& getCheckpoints() const {
+        return checkpoints;
+    }
+
+    /**
+     * @brief Enables loss scaling in train().
+     * @param initial_scale Initial loss scale (default 2^16).
+     * @param dynamic Adjust the scale on overflow / after clean steps (default true).
+     * @param growth_interval Clean steps before the scale is doubled (default 2000).
+     */
+    void enableLossScaling(double initial_scale = 65536.0, bool dynamic = true,
+                           size_t growth_interval = 2000);
+
+    /**
+     * @brief Disables loss scaling.
+     */
+    void disableLossScaling();
+
+    /**
+     * @brief Get the current loss scale (1.0 when disabled).
+     */
+    double getLossScale() const {
+        return loss_scaling_enabled ? loss_scale : 1.0;
+    }
+
     /**
      * @brief Clear all cached gradients of all layers
      */
     void clearGradients();
+
+    /**
+     * @brief Registers the trainable buffers of all layers and returns the table.
+     *
+     * Lets custom training loops call optimizer.step(model.getParameters(), n)
+     * without building a layer list per step. The table stays valid until a
+     * layer is replaced (e.g. by fuseLayers).
+     */
+    const ParameterRegistry& getParameters() {
+        registerParameters();
+        return parameters;
+    }
+
+    /**
+     * @brief Packs all parameters into one value buffer and one gradient buffer.
+     *
+     * Every layer's weights and biases are moved into consecutive ranges of a
+     * single model-wide buffer (gradients likewise), in layer order; the
+     * layers keep working on views into it. Gradient zeroing, loss-scale
+     * checks and global-norm clipping then run as one linear pass, replicas
+     * are refreshed with one copy per batch, and getParameters().values() /
+     * gradients() give the whole model for checkpoints or gradient exchange.
+     * Stays on for later training calls; layers replaced afterwards (e.g. by
+     * fuseLayers) are packed at the next registry build.
+     *
+     * @throws std::logic_error If a layer registers parameters but does not implement bindParameters.
+     */
+    void flattenParameters();
+
+    /**
+     * @brief Whether flattenParameters() has been called.
+     */
+    bool hasFlatParameters() const {
+        return flat_parameters;
+    }
         
     /**
      * @brief Access layer by index.
@@ -192,3 +829,202 @@ public:
     }
 
 };
+
+template <typename Loss>
+double Sequential::train(
+    const Dataset& X_train,
+    const Dataset& y_train,
+    BaseOptim& optimizer,
+    const Loss& loss,
+    unsigned int seed
+) {
+    if (X_train.rows() != y_train.rows()) {
+        throw std::invalid_argument("Sequential::train: X_train and y_train row counts differ");
+    }
+    size_t batch_size = optimizer.getBatchSize();
+    if (batch_size == 0) {
+        batch_size = X_train.rows();
+        optimizer.setBatchSize(batch_size);
+    }
+    DataLoader loader(X_train, batch_size, true, seed);
+    registerParameters();
+    const std::vector<size_t>& order = loader.getOrder();
+    const size_t num_batches = loader.numBatches();
+    Reduction::CompensatedSum total_loss;
+
+    for (size_t b = 0; b < num_batches; ++b) {
+        const size_t* batch_indices = order.data() + b * batch_size;
+        const size_t current_batch_size = std::min(batch_size, order.size() - b * batch_size);
+        const Scalar grad_scale = static_cast<Scalar>(
+            (loss_scaling_enabled ? loss_scale : 1.0) / current_batch_size);
+
+        // clear gradient cache
+        parameters.zeroGradients();
+        const size_t micro_size = microBatchSize(current_batch_size);
+        const size_t shards = prepareWorkers(micro_size);
+
+        // Micro-batches accumulate into the same gradients; one step per batch
+        for (size_t begin = 0; begin < current_batch_size; begin += micro_size) {
+            const size_t* micro_indices = batch_indices + begin;
+            total_loss += runShards(std::min(micro_size, current_batch_size - begin), shards,
+                [&](std::vector<std::unique_ptr<BaseLayer>>& stack, size_t k, Worker& worker) {
+                    return trainSample(stack, X_train[micro_indices[k]], y_train[micro_indices[k]],
+                                       loss, grad_scale, worker);
+                });
+        }
+        reduceWorkerGradients(shards);
+
+        // Update parameters and notify optimizer (for schedulers)
+        optimizerStep(optimizer, current_batch_size, parameters);
+    }
+    return total_loss.result() / X_train.rows();
+}
+
+template <typename SampleFn>
+double Sequential::runShards(size_t count, size_t shards, SampleFn&& sample_fn)
+{
+    ThreadPool::global().parallelFor(0, shards, [&](size_t lo, size_t hi) {
+        for (size_t s = lo; s < hi; ++s) {
+            Worker& worker = workers[s];
+            auto& stack = s == 0 ? this->layers : worker.layers;
+            worker.loss = Reduction::CompensatedSum();
+            const size_t begin = count * s / shards;
+            const size_t end = count * (s + 1) / shards;
+            for (size_t k = begin; k < end; ++k) {
+                worker.loss += sample_fn(stack, k, worker);
+            }
+        }
+    }, 1);
+
+    Reduction::CompensatedSum batch_loss;
+    for (size_t s = 0; s < shards; ++s) batch_loss += workers[s].loss.result();
+    return batch_loss.result();
+}
+
+template <typename Loss>
+double Sequential::trainSample(std::vector<std::unique_ptr<BaseLayer>>& stack,
+                               const std::vector<Scalar>& x, const std::vector<Scalar>& y_true,
+                               const Loss& loss, Scalar grad_scale, Worker& worker)
+{
+    const size_t out_dim = y_true.size();
+    std::vector<Scalar>& buffer = worker.buffer;     // activations forward, gradients backward
+    worker.loss_grad.resize(out_dim);
+
+    forwardStack(stack, x, worker);
+    if (buffer.size() != out_dim) {
+        throw std::invalid_argument("Sequential::train: Model output size does not match y_train columns");
+    }
+
+    // Row term of the batch mean (losses are means over rows)
+    const double sample_loss = loss.forwardBackward(
+        ConstMatrixView(y_true.data(), 1, out_dim),
+        ConstMatrixView(buffer.data(), 1, out_dim),
+        MatrixView(worker.loss_grad.data(), 1, out_dim));
+
+    for (size_t j = 0; j < out_dim; ++j) buffer[j] = worker.loss_grad[j] * grad_scale;
+    backwardStack(stack, buffer, worker);
+    return sample_loss;
+}
+
+template <typename Loss>
+Sequential::Evaluation Sequential::evaluate(const Dataset& X, const Dataset& y, const Loss& loss) const {
+    if (X.rows() == 0 || X.rows() != y.rows()) {
+        throw std::invalid_argument("Sequential::evaluate: X and y must have the same, non-zero number of rows");
+    }
+    const size_t rows = X.rows();
+    const size_t cols = outputSize(X.cols());
+    if (y.cols() != cols) {
+        throw std::invalid_argument("Sequential::evaluate: Target width " + std::to_string(y.cols()) +
+                                    " does not match the model output width " + std::to_string(cols));
+    }
+
+    std::vector<Scalar> outputs(rows * cols);
+    predictInto(X, MatrixView(outputs, rows, cols));
+
+    auto classOf = [cols](const Scalar* row) -> size_t {
+        if (cols == 1) return row[0] > Scalar(0.5) ? 1 : 0;
+        return static_cast<size_t>(std::max_element(row, row + cols) - row);
+    };
+
+    Evaluation result;
+    result.predictions.resize(rows);
+    std::vector<unsigned char> hits(rows);
+    const double total = Reduction::sum(rows, [&](size_t i) {
+        const Scalar* output = &outputs[i * cols];
+        result.predictions[i] = classOf(output);
+        hits[i] = result.predictions[i] == classOf(y[i].data());
+        return loss.forward(ConstMatrixView(y[i].data(), 1, cols), ConstMatrixView(output, 1, cols));
+    }, std::max<size_t>(1, Reduction::kBlockSize / cols));
+
+    size_t correct = 0;
+    for (unsigned char hit : hits) correct += hit;
+    result.loss = total / rows;
+    result.accuracy = static_cast<double>(correct) / rows;
+    return result;
+}
+
+template <typename Loss>
+double Sequential::trainAsync(
+    const Dataset& X_train,
+    const Dataset& y_train,
+    SGD& optimizer,
+    const Loss& loss,
+    size_t num_workers,
+    unsigned int seed
+) {
+    if (X_train.rows() != y_train.rows()) {
+        throw std::invalid_argument("Sequential::trainAsync: X_train and y_train row counts differ");
+    }
+    if (loss_scaling_enabled) {
+        throw std::logic_error("Sequential::trainAsync: Loss scaling is not supported in asynchronous training");
+    }
+    size_t batch_size = optimizer.getBatchSize();
+    if (batch_size == 0) {
+        batch_size = X_train.rows();
+        optimizer.setBatchSize(batch_size);
+    }
+    DataLoader loader(X_train, batch_size, true, seed);
+    registerParameters();
+    const std::vector<size_t>& order = loader.getOrder();
+    const size_t num_batches = loader.numBatches();
+    if (num_workers == 0) num_workers = ThreadPool::global().size();
+    num_workers = std::max<size_t>(1, std::min(num_workers, num_batches));
+
+    if (workers.size() < num_workers) workers.resize(num_workers);
+    for (size_t w = 0; w < num_workers; ++w) buildReplica(workers[w]);
+    async_versions.assign(SGD::asyncBlockCount(parameters), 0);
+    std::atomic<size_t> next_batch{0};
+
+    ThreadPool::global().parallelFor(0, num_workers, [&](size_t lo, size_t hi) {
+        for (size_t w = lo; w < hi; ++w) {
+            Worker& worker = workers[w];
+            worker.loss = Reduction::CompensatedSum();
+            worker.parameters.zeroGradients();
+            refreshReplica(worker, false);
+
+            for (;;) {
+                const size_t b = next_batch.fetch_add(1, std::memory_order_relaxed);
+                if (b >= num_batches) break;
+                const size_t begin = b * batch_size;
+                const size_t end = std::min(begin + batch_size, order.size());
+                const Scalar grad_scale = static_cast<Scalar>(1.0 / (end - begin));
+
+                // Pick up the blocks written since this worker's last batch (its own included)
+                refreshReplica(worker, true);
+
+                for (size_t k = begin; k < end; ++k) {
+                    worker.loss += trainSample(worker.layers, X_train[order[k]], y_train[order[k]],
+                                               loss, grad_scale, worker);
+                }
+                optimizer.stepAsync(parameters, worker.parameters, worker.velocity, async_versions.data());
+            }
+        }
+    }, 1);
+
+    for (const ParameterGroup& group : parameters.getGroups()) group.layer->parametersChanged();
+    for (size_t b = 0; b < num_batches; ++b) optimizer.afterStep();
+
+    Reduction::CompensatedSum total_loss;
+    for (size_t w = 0; w < num_workers; ++w) total_loss += workers[w].loss.result();
+    return total_loss.result() / X_train.rows();
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include "Models/Sequential.h"
+#include "Layers/StaticDenseLayer.h"
+#include "Layers/StaticActivationLayer.h"
+
+/**
+ * @brief Sequential model whose architecture is a compile-time layer pack.
+ *
+ * Layers are held by value in a std::tuple and called through their
+ * concrete types, so there is no virtual dispatch or heap-allocated layer
+ * list, and the compiler can inline the whole forward / backward chain.
+ * Adjacent widths are checked by static_assert, activations live in stack
+ * buffers sized from the widest layer, and every loop has a compile-time
+ * trip count. Meant for small models whose per-sample latency is dominated
+ * by dispatch and allocation (e.g. the iris classifier):
+ *
+ * @code
+ * using Model = StaticSequential<StaticDenseLayer<4, 8>, StaticActivationLayer<8, ActivationType::RELU>,
+ *                                StaticDenseLayer<8, 3>>;
+ * Model model;
+ * model.initializeParameters(21);
+ * model.train(X, y, optimizer, Losses::CrossEntropyLoss(true));
+ * auto logits = model.predict(Model::Input{5.1, 3.5, 1.4, 0.2});
+ * @endcode
+ *
+ * Training is serial; parameters are registered in a ParameterRegistry, so
+ * every optimizer works unchanged.
+ *
+ * @tparam Layers StaticDenseLayer / StaticActivationLayer types, input to output.
+ */
+template <typename... Layers>
+class StaticSequential {
+    static_assert(sizeof...(Layers) > 0, "StaticSequential: At least one layer is required");
+
+public:
+    static constexpr size_t depth = sizeof...(Layers);
+
+private:
+    template <size_t I>
+    using LayerAt = std::tuple_element_t<I, std::tuple<Layers...>>;
+
+    template <size_t... I>
+    static constexpr bool chained(std::index_sequence<I...>) {
+        return ((LayerAt<I>::output_size == LayerAt<I + 1>::input_size) && ...);
+    }
+    static_assert(chained(std::make_index_sequence<depth - 1>{}),
+                  "StaticSequential: Each layer's output width must equal the next layer's input width");
+
+public:
+    static constexpr size_t input_size = LayerAt<0>::input_size;
+    static constexpr size_t output_size = LayerAt<depth - 1>::output_size;
+    static constexpr size_t max_width = std::max({Layers::input_size..., Layers::output_size...});
+
+    using Input = std::array<Scalar, input_size>;
+    using Output = std::array<Scalar, output_size>;
+
+private:
+    std::tuple<Layers...> layers;
+    ParameterRegistry parameters;   ///< Rebuilt by getParameters(): spans point into the tuple
+
+    using Buffer = std::array<Scalar, max_width>;
+
+    /**
+     * @brief Runs layers I.. on input; a is written by layer I, b is the spare.
+     */
+    template <size_t I>
+    void forwardChain(const Scalar* input, Scalar* a, Scalar* b, Scalar* output) {
+        if constexpr (I + 1 == depth) {
+            std::get<I>(layers).forward(input, output);
+        } else {
+            std::get<I>(layers).forward(input, a);
+            forwardChain<I + 1>(a, b, a, output);
+        }
+    }
+
+    /**
+     * @brief Runs layers I..0 backwards; the first layer's input gradient is skipped.
+     */
+    template <size_t I>
+    void backwardChain(const Scalar* grad, Scalar* a, Scalar* b) {
+        if constexpr (I == 0) {
+            std::get<0>(layers).backward(grad, nullptr);
+        } else {
+            std::get<I>(layers).backward(grad, a);
+            backwardChain<I - 1>(a, b, a);
+        }
+    }
+
+    template <size_t I>
+    void predictChain(const Scalar* input, Scalar* a, Scalar* b, Scalar* output) const {
+        if constexpr (I + 1 == depth) {
+            std::get<I>(layers).predict(input, output);
+        } else {
+            std::get<I>(layers).predict(input, a);
+            predictChain<I + 1>(a, b, a, output);
+        }
+    }
+
+    template <size_t I>
+    void initializeFrom(unsigned int seed, double a, double b, double sparsity, double bias_value) {
+        if constexpr (I < depth) {
+            using Layer = LayerAt<I>;
+            if constexpr (!Layer::is_activation) {
+                // Same choice as Sequential::initializeParameters: by the following activation
+                InitMethod method = InitMethod::XAVIER_UNIFORM;
+                if constexpr (I + 1 < depth) {
+                    if constexpr (LayerAt<I + 1>::is_activation) {
+                        method = Sequential::initMethodFor(LayerAt<I + 1>::activation_type);
+                    }
+                }
+                std::get<I>(layers).initialize(method, seed, a, b, sparsity, bias_value);
+            }
+            initializeFrom<I + 1>(seed, a, b, sparsity, bias_value);
+        }
+    }
+
+    /**
+     * @brief Forward, loss gradient and backward for one sample; returns its loss.
+     */
+    template <typename Loss>
+    double trainSample(const Scalar* x, const Scalar* y_true, const Loss& loss, Scalar grad_scale) {
+        Buffer a, b;
+        Output output, loss_grad;
+        forwardChain<0>(x, a.data(), b.data(), output.data());
+
+        const double sample_loss = loss.forwardBackward(
+            ConstMatrixView(y_true, 1, output_size),
+            ConstMatrixView(output.data(), 1, output_size),
+            MatrixView(loss_grad.data(), 1, output_size));
+        for (size_t j = 0; j < output_size; ++j) loss_grad[j] *= grad_scale;
+
+        backwardChain<depth - 1>(loss_grad.data(), a.data(), b.data());
+        return sample_loss;
+    }
+
+public:
+    StaticSequential() = default;
+
+    /**
+     * @brief Initializes every dense layer, picking the method from the following activation.
+     *
+     * Same rules and arguments as Sequential::initializeParameters.
+     */
+    void initializeParameters(unsigned int seed = MANUAL_SEED, double a = 0, double b = 1.0,
+                              double sparsity = 0.0, double bias_value = 0.1) {
+        initializeFrom<0>(seed, a, b, sparsity, bias_value);
+    }
+
+    /**
+     * @brief Access to layer I with its concrete type.
+     */
+    template <size_t I>
+    LayerAt<I>& layer() { return std::get<I>(layers); }
+
+    template <size_t I>
+    const LayerAt<I>& layer() const { return std::get<I>(layers); }
+
+    /**
+     * @brief Training forward pass (caches activations for backward).
+     */
+    Output forward(const Input& x) {
+        Buffer a, b;
+        Output output;
+        forwardChain<0>(x.data(), a.data(), b.data(), output.data());
+        return output;
+    }
+
+    /**
+     * @brief Backward pass from dL/d(output); accumulates parameter gradients.
+     */
+    void backward(const Output& grad_output) {
+        Buffer a, b;
+        backwardChain<depth - 1>(grad_output.data(), a.data(), b.data());
+    }
+
+    /**
+     * @brief Cache-free inference on stack buffers; const and re-entrant.
+     * @throws std::runtime_error If initializeParameters() was never called.
+     */
+    Output predict(const Input& x) const {
+        Output output;
+        predictInto(x.data(), output.data());
+        return output;
+    }
+
+    /**
+     * @brief Inference from and into caller buffers [input_size] -> [output_size].
+     */
+    void predictInto(const Scalar* x, Scalar* output) const {
+        Buffer a, b;
+        predictChain<0>(x, a.data(), b.data(), output);
+    }
+
+    /**
+     * @brief Inference on a dynamically sized input.
+     * @throws std::invalid_argument If x.size() != input_size.
+     */
+    std::vector<Scalar> predict(const std::vector<Scalar>& x) const {
+        if (x.size() != input_size) {
+            throw std::invalid_argument("StaticSequential::predict: Expected input size " +
+                                        std::to_string(input_size) + ", got " + std::to_string(x.size()));
+        }
+        std::vector<Scalar> output(output_size);
+        predictInto(x.data(), output.data());
+        return output;
+    }
+
+    /**
+     * @brief Registers the trainable buffers of all layers and returns the table.
+     *
+     * Spans point into this object; the table is rebuilt by every call and by
+     * train(), so moving or copying the model is safe between calls.
+     */
+    const ParameterRegistry& getParameters() {
+        parameters.clear();
+        std::apply([this](auto&... layer) { (parameters.add(layer), ...); }, layers);
+        return parameters;
+    }
+
+    /**
+     * @brief One epoch of mini-batch training (serial), as Sequential::train.
+     *
+     * @param X_train Inputs [rows x input_size].
+     * @param y_train Targets [rows x output_size].
+     * @param optimizer Any optimizer; its batch size sets the mini-batch (0 = full batch).
+     * @param loss Loss object (see Metrics/LossFunctions.h).
+     * @param seed Shuffling seed.
+     * @return Mean training loss over the epoch.
+     * @throws std::runtime_error If initializeParameters() was never called.
+     */
+    template <typename Loss>
+    double train(const Dataset& X_train, const Dataset& y_train, BaseOptim& optimizer,
+                 const Loss& loss, unsigned int seed = MANUAL_SEED) {
+        if (X_train.rows() != y_train.rows()) {
+            throw std::invalid_argument("StaticSequential::train: X_train and y_train row counts differ");
+        }
+        if (X_train.cols() != input_size || y_train.cols() != output_size) {
+            throw std::invalid_argument("StaticSequential::train: Expected [rows x " + std::to_string(input_size) +
+                                        "] inputs and [rows x " + std::to_string(output_size) + "] targets");
+        }
+        size_t batch_size = optimizer.getBatchSize();
+        if (batch_size == 0) {
+            batch_size = X_train.rows();
+            optimizer.setBatchSize(batch_size);
+        }
+        DataLoader loader(X_train, batch_size, true, seed);
+        getParameters();
+        const std::vector<size_t>& order = loader.getOrder();
+        const size_t num_batches = loader.numBatches();
+        Reduction::CompensatedSum total_loss;
+
+        for (size_t b = 0; b < num_batches; ++b) {
+            const size_t begin = b * batch_size;
+            const size_t end = std::min(begin + batch_size, order.size());
+            const Scalar grad_scale = static_cast<Scalar>(1.0 / (end - begin));
+
+            parameters.zeroGradients();
+            for (size_t k = begin; k < end; ++k) {
+                total_loss += trainSample(X_train[order[k]].data(), y_train[order[k]].data(), loss, grad_scale);
+            }
+            optimizer.step(parameters, end - begin);
+            optimizer.afterStep();
+        }
+        return total_loss.result() / X_train.rows();
+    }
+
+    /**
+     * @brief Loss and accuracy over a dataset, scored like Sequential::evaluate.
+     */
+    template <typename Loss>
+    Sequential::Evaluation evaluate(const Dataset& X, const Dataset& y, const Loss& loss) const {
+        if (X.rows() == 0 || X.rows() != y.rows()) {
+            throw std::invalid_argument("StaticSequential::evaluate: X and y must have the same, non-zero number of rows");
+        }
+        if (X.cols() != input_size || y.cols() != output_size) {
+            throw std::invalid_argument("StaticSequential::evaluate: Expected [rows x " + std::to_string(input_size) +
+                                        "] inputs and [rows x " + std::to_string(output_size) + "] targets");
+        }
+        auto classOf = [](const Scalar* row) -> size_t {
+            if (output_size == 1) return row[0] > Scalar(0.5) ? 1 : 0;
+            return static_cast<size_t>(std::max_element(row, row + output_size) - row);
+        };
+
+        const size_t rows = X.rows();
+        Sequential::Evaluation result;
+        result.predictions.resize(rows);
+        std::vector<unsigned char> hits(rows);
+        const double total = Reduction::sum(rows, [&](size_t i) {
+            Output output;
+            predictInto(X[i].data(), output.data());
+            result.predictions[i] = classOf(output.data());
+            hits[i] = result.predictions[i] == classOf(y[i].data());
+            return loss.forward(ConstMatrixView(y[i].data(), 1, output_size),
+                                ConstMatrixView(output.data(), 1, output_size));
+        });
+
+        size_t correct = 0;
+        for (unsigned char hit : hits) correct += hit;
+        result.loss = total / rows;
+        result.accuracy = static_cast<double>(correct) / rows;
+        return result;
+    }
+
+    /**
+     * @brief Prints every layer's summary and the parameter count.
+     */
+    void summary() const {
+        std::cout << "StaticSequential: " << depth << " layers, " << input_size << " -> " << output_size << "\n";
+        std::apply([](const auto&... layer) { (layer.summary(), ...); }, layers);
+    }
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "AdaptiveOptim.h"
+
+/**
+ * @brief Adagrad: step sizes shrink with the accumulated squared gradients.
+ *
+ * State: 1 value per parameter.
+ */
+class Adagrad : public AdaptiveOptim {
+private:
+    double epsilon;
+    double weight_decay;
+    double initial_accumulator;
+
+    size_t stateSlots() const override { return 1; }
+    void initState(Scalar* layer_state, size_t count) override;
+    void updateLayer(const ParameterGroup& group, Scalar* layer_state) override;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param lr Learning rate (default=0.01).
+     * @param epsilon Denominator stabiliser (default=1e-10).
+     * @param weight_decay L2 penalty (default=0).
+     * @param initial_accumulator Starting value of the squared-gradient sum (default=0).
+     * @param batch_size Size of mini batch.
+     * @param scheduler Learning rate scheduler function (init_lr, step) -> new_lr.
+     * @throws std::invalid_argument If epsilon <= 0 or initial_accumulator < 0.
+     */
+    Adagrad(double lr = 0.01,
+            double epsilon = 1e-10,
+            double weight_decay = 0.0,
+            double initial_accumulator = 0.0,
+            size_t batch_size = 0,
+            std::function<double(double, size_t)> scheduler = nullptr);
+};
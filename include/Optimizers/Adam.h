@@ -0,0 +1,68 @@
+#pragma once
+
+#include "AdaptiveOptim.h"
+
+/**
+ * @brief Adam: per-parameter step sizes from bias-corrected first and second moments.
+ *
+ * weight_decay adds an L2 term to the gradient (coupled, as in the original
+ * paper); use AdamW for decoupled decay. State: 2 values per parameter.
+ */
+class Adam : public AdaptiveOptim {
+protected:
+    double beta1;
+    double beta2;
+    double epsilon;
+    double weight_decay;
+    bool decoupled_decay = false;
+
+    size_t stateSlots() const override { return 2; }
+    void updateLayer(const ParameterGroup& group, Scalar* layer_state) override;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param lr Learning rate (default=0.001).
+     * @param beta1 First-moment decay (default=0.9).
+     * @param beta2 Second-moment decay (default=0.999).
+     * @param epsilon Denominator stabiliser (default=1e-8).
+     * @param weight_decay L2 penalty (default=0).
+     * @param batch_size Size of mini batch.
+     * @param scheduler Learning rate scheduler function (init_lr, step) -> new_lr.
+     * @throws std::invalid_argument If a beta is outside [0, 1) or epsilon <= 0.
+     */
+    Adam(double lr = 0.001,
+         double beta1 = 0.9,
+         double beta2 = 0.999,
+         double epsilon = 1e-8,
+         double weight_decay = 0.0,
+         size_t batch_size = 0,
+         std::function<double(double, size_t)> scheduler = nullptr);
+
+    void setWeightDecay(double wd) { weight_decay = wd; }
+    double getWeightDecay() const { return weight_decay; }
+};
+
+/**
+ * @brief AdamW: Adam with decoupled weight decay (p -= lr * wd * p each step).
+ */
+class AdamW : public Adam {
+public:
+    /**
+     * @brief Constructor.
+     * @param lr Learning rate (default=0.001).
+     * @param weight_decay Decoupled weight decay (default=0.01).
+     * @param beta1 First-moment decay (default=0.9).
+     * @param beta2 Second-moment decay (default=0.999).
+     * @param epsilon Denominator stabiliser (default=1e-8).
+     * @param batch_size Size of mini batch.
+     * @param scheduler Learning rate scheduler function (init_lr, step) -> new_lr.
+     */
+    AdamW(double lr = 0.001,
+          double weight_decay = 0.01,
+          double beta1 = 0.9,
+          double beta2 = 0.999,
+          double epsilon = 1e-8,
+          size_t batch_size = 0,
+          std::function<double(double, size_t)> scheduler = nullptr);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "BaseOptim.h"
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+/**
+ * @brief Common base of the adaptive optimizers (Adam, AdamW, RMSProp, Adagrad).
+ *
+ * Holds the learning-rate / scheduler / clipping plumbing shared with SGD and
+ * a flat per-layer state buffer of stateSlots() x group.count values
+ * (e.g. first and second moments). step() looks the buffer up once per layer
+ * and hands it to updateLayer(), which runs a fused kernel from
+ * UpdateKernels over the layer's parameter spans.
+ */
+class AdaptiveOptim : public BaseOptim {
+protected:
+    double learning_rate;
+    double initial_lr;
+    size_t batch_size;
+    double clip_value_ = 0;                 ///< Element-wise gradient clip (0 = off)
+    double clip_norm_ = 0;                  ///< Global-norm clip threshold (0 = off)
+    double grad_scale_ = 1.0;               ///< Global-norm clip factor of the current step
+    double last_grad_norm_ = 0;             ///< Global gradient norm seen by the last step
+    size_t update_count = 0;                ///< Updates applied (t in bias corrections)
+
+    // Learning rate scheduler
+    std::function<double(double, size_t)> lr_scheduler = nullptr;
+    size_t step_count = 0;
+
+    /// Flat state per layer: slot k of parameter i is at k * count + i
+    std::unordered_map<BaseLayer*, std::vector<Scalar>> state;
+
+    AdaptiveOptim(double lr, size_t batch_size, std::function<double(double, size_t)> scheduler);
+
+    /**
+     * @brief Number of state values kept per parameter.
+     */
+    virtual size_t stateSlots() const = 0;
+
+    /**
+     * @brief Initialises a freshly allocated (zero-filled) state buffer.
+     */
+    virtual void initState(Scalar* /*layer_state*/, size_t /*count*/) {}
+
+    /**
+     * @brief Applies the optimizer's fused kernel to one layer.
+     * @param group The layer's registered parameter spans.
+     * @param layer_state Flat state buffer [stateSlots() * group.count].
+     */
+    virtual void updateLayer(const ParameterGroup& group, Scalar* layer_state) = 0;
+
+public:
+    using BaseOptim::step;
+    void step(const ParameterRegistry& parameters, size_t batch_size) override;
+    void afterStep() override;
+    void setLearningRate(double lr) override;
+    void decayLearningRate(double decay_factor) override;
+    double getLearningRate() const override { return learning_rate; }
+    size_t getBatchSize() const override { return this->batch_size; }
+    void setBatchSize(size_t new_batch_size) override { this->batch_size = new_batch_size; }
+
+    void setGradientClip(double clip) { clip_value_ = clip; }
+
+    /**
+     * @brief Rescales the whole gradient so its global L2 norm is at most max_norm.
+     * @param max_norm Threshold (0 disables). Combines with setGradientClip (norm first).
+     */
+    void setGradientClipNorm(double max_norm) { clip_norm_ = max_norm; }
+
+    /**
+     * @brief Global gradient norm before clipping in the last step (0 unless norm clipping is on).
+     */
+    double getLastGradientNorm() const { return last_grad_norm_; }
+
+    void setLRScheduler(std::function<double(double, size_t)> scheduler);
+    void resetStepCount() { step_count = 0; }
+
+    /**
+     * @brief Drops all optimizer state (moments and update count).
+     */
+    void resetState();
+};
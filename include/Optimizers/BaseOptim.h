@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Layers/BaseLayer.h"
+#include "Layers/ParameterRegistry.h"
 #include <vector>
 #include <memory>
 
@@ -11,12 +12,24 @@ class BaseOptim {
 public:
     virtual ~BaseOptim() = default;
     
-    /**     
+    /**
+     * @brief Update every registered parameter group.
+     * @param parameters Prebuilt parameter table (e.g. Sequential's registry).
+     * @param batch_size Batch size used in the current step.
+     */
+    virtual void step(const ParameterRegistry& parameters, size_t batch_size) = 0;
+
+    /**
      * @brief Update parameters for a set of layers.
+     *
+     * Convenience overload: registers the layers' parameters, then steps.
+     *
      * @param layers Vector of layer pointers to update.
      * @param batch_size Batch size used in the current step.
      */
-    virtual void step(std::vector<BaseLayer*> layers, size_t batch_size) = 0;
+    void step(const std::vector<BaseLayer*>& layers, size_t batch_size) {
+        step(ParameterRegistry(layers), batch_size);
+    }
 
     virtual void afterStep() = 0;  // Add this method
     
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Layers/ParameterRegistry.h"
+
+/**
+ * @file GradientClipping.h
+ * @brief Global-norm gradient clipping shared by all optimizers.
+ *
+ * The L2 norm is taken over the gradients of every trainable layer at once,
+ * so clipping rescales the whole update and keeps its direction (unlike
+ * element-wise clamping). The norm is one deterministic parallel reduction;
+ * the resulting factor is passed to the fused update kernels as grad_scale,
+ * so applying it costs nothing extra.
+ */
+namespace GradientClipping {
+
+    /**
+     * @brief L2 norm of all registered gradients.
+     */
+    double globalNorm(const ParameterRegistry& parameters);
+
+    /**
+     * @brief Scale factor min(1, max_norm / norm) (1 when max_norm <= 0 or norm is 0).
+     */
+    double scaleFactor(double norm, double max_norm);
+
+} // namespace GradientClipping
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "AdaptiveOptim.h"
+
+/**
+ * @brief LAMB: Adam direction with a layer-wise trust ratio for large batches.
+ *
+ * For each layer's weight matrix the Adam update u (with decoupled decay
+ * wd * w) is rescaled by trust = ||w|| / ||u|| (1 if either norm is 0).
+ * The first pass updates the moments and reduces ||u||^2 over the weight
+ * rows in parallel; the second applies w -= lr * trust * u. Biases take a
+ * plain Adam step without decay. State: 2 values per parameter.
+ */
+class LAMB : public AdaptiveOptim {
+private:
+    double beta1;
+    double beta2;
+    double epsilon;
+    double weight_decay;
+
+    size_t stateSlots() const override { return 2; }
+    void updateLayer(const ParameterGroup& group, Scalar* layer_state) override;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param lr Learning rate (default=0.001).
+     * @param beta1 First-moment decay (default=0.9).
+     * @param beta2 Second-moment decay (default=0.999).
+     * @param epsilon Denominator stabiliser (default=1e-6).
+     * @param weight_decay Decoupled weight decay on weights (default=0.01).
+     * @param batch_size Size of mini batch.
+     * @param scheduler Learning rate scheduler function (init_lr, step) -> new_lr.
+     * @throws std::invalid_argument If a beta is outside [0, 1) or epsilon <= 0.
+     */
+    LAMB(double lr = 0.001,
+         double beta1 = 0.9,
+         double beta2 = 0.999,
+         double epsilon = 1e-6,
+         double weight_decay = 0.01,
+         size_t batch_size = 0,
+         std::function<double(double, size_t)> scheduler = nullptr);
+};
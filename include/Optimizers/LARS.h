@@ -0,0 +1,43 @@
+#pragma once
+
+#include "AdaptiveOptim.h"
+
+/**
+ * @brief LARS: SGD with momentum and a layer-wise trust ratio for large batches.
+ *
+ * For each layer's weight matrix
+ * trust = eta * ||w|| / (||g|| + wd * ||w|| + eps) (1 if either norm is 0),
+ * and the weights take a momentum step with lr * trust. Biases use the plain
+ * learning rate without weight decay. The two norms are deterministic
+ * parallel reductions over the weight rows. State: 1 value per parameter.
+ */
+class LARS : public AdaptiveOptim {
+private:
+    double momentum;
+    double weight_decay;
+    double trust_coefficient;
+    double epsilon;
+
+    size_t stateSlots() const override { return 1; }
+    void updateLayer(const ParameterGroup& group, Scalar* layer_state) override;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param lr Global learning rate (default=0.1).
+     * @param momentum Momentum factor (default=0.9).
+     * @param weight_decay L2 penalty on weights (default=0).
+     * @param trust_coefficient eta in the trust ratio (default=0.001).
+     * @param epsilon Denominator stabiliser (default=1e-8).
+     * @param batch_size Size of mini batch.
+     * @param scheduler Learning rate scheduler function (init_lr, step) -> new_lr.
+     * @throws std::invalid_argument If trust_coefficient <= 0 or epsilon < 0.
+     */
+    LARS(double lr = 0.1,
+         double momentum = 0.9,
+         double weight_decay = 0.0,
+         double trust_coefficient = 0.001,
+         double epsilon = 1e-8,
+         size_t batch_size = 0,
+         std::function<double(double, size_t)> scheduler = nullptr);
+};
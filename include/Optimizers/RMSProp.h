@@ -0,0 +1,42 @@
+#pragma once
+
+#include "AdaptiveOptim.h"
+
+/**
+ * @brief RMSProp: divides the step by a running RMS of recent gradients.
+ *
+ * State: the squared-gradient average, plus a momentum buffer when
+ * momentum > 0 (2 values per parameter are always reserved).
+ */
+class RMSProp : public AdaptiveOptim {
+private:
+    double alpha;
+    double epsilon;
+    double momentum;
+    double weight_decay;
+
+    size_t stateSlots() const override { return 2; }
+    void updateLayer(const ParameterGroup& group, Scalar* layer_state) override;
+
+public:
+    /**
+     * @brief Constructor.
+     * @param lr Learning rate (default=0.01).
+     * @param alpha Smoothing constant (default=0.99).
+     * @param epsilon Denominator stabiliser (default=1e-8).
+     * @param momentum Momentum factor (default=0).
+     * @param weight_decay L2 penalty (default=0).
+     * @param batch_size Size of mini batch.
+     * @param scheduler Learning rate scheduler function (init_lr, step) -> new_lr.
+     * @throws std::invalid_argument If alpha is outside [0, 1) or epsilon <= 0.
+     */
+    RMSProp(double lr = 0.01,
+            double alpha = 0.99,
+            double epsilon = 1e-8,
+            double momentum = 0.0,
+            double weight_decay = 0.0,
+            size_t batch_size = 0,
+            std::function<double(double, size_t)> scheduler = nullptr);
+
+    void setMomentum(double m) { momentum = m; }
+};
@@ -4,23 +4,34 @@
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <cstdint>
 
+/**
+ * @brief Stochastic gradient descent with momentum, clipping and LR scheduling.
+ *
+ * Updates always apply to the Scalar master weights of each DenseLayer; with
+ * mixed-precision storage enabled the layer re-encodes its 16-bit weight copy
+ * after the update, so rounding error never accumulates in the master copy.
+ * Each layer is updated in place by UpdateKernels::sgd, one fused pass that
+ * clips, applies momentum, updates and zeroes the gradients.
+ */
 class SGD : public BaseOptim {
 private:
     double learning_rate;
     double initial_lr;
     double momentum;
     size_t batch_size;
-    std::unordered_map<BaseLayer*, std::vector<std::vector<double>>> velocity_weights;
-    std::unordered_map<BaseLayer*, std::vector<double>> velocity_biases;
+    std::unordered_map<BaseLayer*, std::vector<Scalar>> velocity;  ///< Flat [weights | biases] per layer
     double clip_value_ = 0;  // Add clipping threshold
+    double clip_norm_ = 0;       ///< Global-norm clip threshold (0 = off)
+    double grad_scale_ = 1.0;    ///< Global-norm clip factor of the current step
+    double last_grad_norm_ = 0;  ///< Global gradient norm seen by the last step (when clipping by norm)
 
     /**
-     * @brief Updates parameters for a single layer.
-     * @param layer Pointer to the layer to update.
-     * @param batch_size Batch size for gradient normalization.
+     * @brief Updates the parameters of a single layer.
+     * @param group The layer's registered parameter spans.
      */
-    void updateLayer(BaseLayer* layer, size_t batch_size);
+    void updateLayer(const ParameterGroup& group);
 
     // Learning rate scheduler
     std::function<double(double, size_t)> lr_scheduler = nullptr;
@@ -40,7 +51,8 @@ public:
         std::function<double(double, size_t)> scheduler = nullptr);
     
     // Implement BaseOptim interface
-    void step(std::vector<BaseLayer*> layers, size_t batch_size) override;
+    using BaseOptim::step;
+    void step(const ParameterRegistry& parameters, size_t batch_size) override;
     void setLearningRate(double lr) override ;
     void decayLearningRate(double decay_factor) override ; 
     double getLearningRate() const override { return learning_rate; }
@@ -56,6 +68,54 @@ public:
 
     void setGradientClip(double clip) { clip_value_ = clip; }
 
+    /**
+     * @brief Rescales the whole gradient so its global L2 norm is at most max_norm.
+     * @param max_norm Threshold (0 disables). Combines with setGradientClip (norm first).
+     */
+    void setGradientClipNorm(double max_norm) { clip_norm_ = max_norm; }
+
+    /**
+     * @brief Global gradient norm before clipping in the last step (0 unless norm clipping is on).
+     */
+    double getLastGradientNorm() const { return last_grad_norm_; }
+
+    /**
+     * @brief Hogwild step: applies a worker's gradients to shared weights without locks.
+     *
+     * Uses this optimizer's learning rate, momentum and clipping (the global
+     * norm is taken over the worker's gradients). Every shared parameter
+     * with a non-zero step is updated with a relaxed atomic load/store
+     * (UpdateKernels::sgdHogwild), the others are not touched, and the
+     * optimizer itself is only read, so any number of workers may call it
+     * concurrently. Schedulers are not advanced.
+     *
+     * Spans are updated in blocks of kAsyncBlock values. When block_versions
+     * is given, the counter of every block that received a non-zero step is
+     * incremented (release), so workers can refresh their replicas from only
+     * the blocks that changed (see asyncBlockCount for the numbering).
+     *
+     * @param shared Parameters updated by all workers.
+     * @param worker Registry of the worker's replica of the same layers; its gradients are zeroed.
+     * @param velocity Worker-local momentum buffers, one per group (sized on first use).
+     * @param block_versions Shared write counters [asyncBlockCount(shared)], or nullptr.
+     * @throws std::invalid_argument If the registries differ in shape.
+     */
+    void stepAsync(const ParameterRegistry& shared,
+                   const ParameterRegistry& worker,
+                   std::vector<std::vector<Scalar>>& velocity,
+                   uint32_t* block_versions = nullptr) const;
+
+    /// Values per version block of stepAsync
+    static constexpr size_t kAsyncBlock = 64;
+
+    /**
+     * @brief Number of stepAsync version blocks of a registry.
+     *
+     * Every span is cut into ceil(size / kAsyncBlock) blocks, numbered
+     * consecutively over the spans of all groups in registry order.
+     */
+    static size_t asyncBlockCount(const ParameterRegistry& registry);
+
     // New scheduling features
     void setLRScheduler(std::function<double(double, size_t)> scheduler);
     void resetStepCount() { step_count = 0; }
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cstddef>
+#include "../Utils/Precision.h"
+
+/**
+ * @file UpdateKernels.h
+ * @brief Fused in-place parameter update kernels over flat spans.
+ *
+ * Each kernel makes one streaming pass over n contiguous parameters, their
+ * gradients and the optimizer state: clip the gradient, update the state,
+ * update the parameter and zero the gradient for the next batch. The loops
+ * are branch-free (clipping is a min/max) so they vectorise, and nothing is
+ * copied or allocated. grad_scale multiplies every gradient before clipping;
+ * optimizers pass the global-norm clip factor there so norm clipping costs
+ * no extra pass. Optimizers call them once per span handed out by
+ * ParameterRegistry::update.
+ */
+namespace UpdateKernels {
+
+    /**
+     * @brief SGD with optional momentum: v = momentum * v + lr * g; p -= v.
+     *
+     * @param params Parameters [n], updated in place.
+     * @param grads Gradients [n], zeroed on return.
+     * @param velocity Momentum buffer [n]; ignored (may be nullptr) when momentum == 0.
+     * @param n Span length.
+     * @param lr Learning rate.
+     * @param momentum Momentum factor (0 = plain SGD, p -= lr * g).
+     * @param clip Element-wise clip threshold for g (0 = no clipping).
+     * @param grad_scale Factor applied to g before clipping (global-norm clip).
+     */
+    void sgd(Scalar* params, Scalar* grads, Scalar* velocity, size_t n,
+             double lr, double momentum, double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief Lock-free SGD step on parameters shared between threads (Hogwild).
+     *
+     * Same update as sgd(), but params belong to another owner: every element
+     * is read and written with a relaxed atomic load/store (Atomics.h), so
+     * concurrent workers never tear a value but may overwrite each other's
+     * update of the same element. grads and velocity are worker-private.
+     * Elements whose step is zero (zero gradient, and zero velocity with
+     * momentum) are not written, so sparse gradients store only what changed
+     * and cannot overwrite another worker's update of the untouched rest.
+     *
+     * @param params Shared parameters [n], updated in place.
+     * @param grads Worker gradients [n], zeroed on return.
+     * @param velocity Worker momentum buffer [n]; ignored (may be nullptr) when momentum == 0.
+     * @param n Span length.
+     * @param lr Learning rate.
+     * @param momentum Momentum factor (0 = plain SGD).
+     * @param clip Element-wise clip threshold for g (0 = no clipping).
+     * @param grad_scale Factor applied to g before clipping (global-norm clip).
+     * @return True if at least one shared element was written.
+     */
+    bool sgdHogwild(Scalar* params, Scalar* grads, Scalar* velocity, size_t n,
+                    double lr, double momentum, double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief Adam / AdamW.
+     *
+     * m = b1 m + (1 - b1) g; v = b2 v + (1 - b2) g^2;
+     * p -= lr (m / bc1) / (sqrt(v / bc2) + eps), with bias corrections
+     * bc1 = 1 - b1^t, bc2 = 1 - b2^t. Weight decay is added to g (L2, Adam)
+     * or applied as p -= lr * wd * p (decoupled, AdamW).
+     *
+     * @param params Parameters [n], updated in place.
+     * @param grads Gradients [n], zeroed on return.
+     * @param m First-moment buffer [n].
+     * @param v Second-moment buffer [n].
+     * @param n Span length.
+     * @param lr Learning rate.
+     * @param beta1 First-moment decay.
+     * @param beta2 Second-moment decay.
+     * @param eps Denominator stabiliser.
+     * @param bias_correction1 1 - beta1^t.
+     * @param bias_correction2 1 - beta2^t.
+     * @param weight_decay Weight decay factor (0 = none).
+     * @param decoupled Apply weight decay directly to the parameters (AdamW).
+     * @param clip Element-wise clip threshold for g (0 = no clipping).
+     * @param grad_scale Factor applied to g before clipping (global-norm clip).
+     */
+    void adam(Scalar* params, Scalar* grads, Scalar* m, Scalar* v, size_t n,
+              double lr, double beta1, double beta2, double eps,
+              double bias_correction1, double bias_correction2,
+              double weight_decay, bool decoupled, double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief RMSProp: s = a s + (1 - a) g^2; p -= lr g / (sqrt(s) + eps).
+     *
+     * With momentum > 0 the step is accumulated in a buffer first:
+     * b = momentum b + g / (sqrt(s) + eps); p -= lr b.
+     *
+     * @param params Parameters [n], updated in place.
+     * @param grads Gradients [n], zeroed on return.
+     * @param square_avg Running mean of g^2 [n].
+     * @param momentum_buffer Momentum buffer [n]; ignored (may be nullptr) when momentum == 0.
+     * @param n Span length.
+     * @param lr Learning rate.
+     * @param alpha Smoothing constant of the squared-gradient average.
+     * @param eps Denominator stabiliser.
+     * @param momentum Momentum factor.
+     * @param weight_decay L2 penalty added to g (0 = none).
+     * @param clip Element-wise clip threshold for g (0 = no clipping).
+     * @param grad_scale Factor applied to g before clipping (global-norm clip).
+     */
+    void rmsprop(Scalar* params, Scalar* grads, Scalar* square_avg, Scalar* momentum_buffer, size_t n,
+                 double lr, double alpha, double eps, double momentum,
+                 double weight_decay, double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief Adagrad: s += g^2; p -= lr g / (sqrt(s) + eps).
+     *
+     * @param params Parameters [n], updated in place.
+     * @param grads Gradients [n], zeroed on return.
+     * @param sum_sq Accumulated squared gradients [n].
+     * @param n Span length.
+     * @param lr Learning rate.
+     * @param eps Denominator stabiliser.
+     * @param weight_decay L2 penalty added to g (0 = none).
+     * @param clip Element-wise clip threshold for g (0 = no clipping).
+     * @param grad_scale Factor applied to g before clipping (global-norm clip).
+     */
+    void adagrad(Scalar* params, Scalar* grads, Scalar* sum_sq, size_t n,
+                 double lr, double eps, double weight_decay, double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief LARS step for one span: v = momentum v + local_lr (g + wd p); p -= v.
+     *
+     * local_lr is the layer's learning rate times its trust ratio.
+     *
+     * @param params Parameters [n], updated in place.
+     * @param grads Gradients [n], zeroed on return.
+     * @param velocity Momentum buffer [n].
+     * @param n Span length.
+     * @param local_lr Learning rate scaled by the trust ratio.
+     * @param momentum Momentum factor.
+     * @param weight_decay L2 penalty added to g (0 = none).
+     * @param clip Element-wise clip threshold for g (0 = no clipping).
+     * @param grad_scale Factor applied to g before clipping (global-norm clip).
+     */
+    void lars(Scalar* params, Scalar* grads, Scalar* velocity, size_t n,
+              double local_lr, double momentum, double weight_decay,
+              double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief LAMB first pass: Adam moments and the squared norm of the update direction.
+     *
+     * Updates m and v like adam(), zeroes the gradients and returns
+     * sum u^2 with u = (m / bc1) / (sqrt(v / bc2) + eps) + wd p; the caller
+     * turns ||p|| / ||u|| into the trust ratio and calls lambApply().
+     *
+     * @return Sum of u^2 over the span.
+     */
+    double lambMoments(const Scalar* params, Scalar* grads, Scalar* m, Scalar* v, size_t n,
+                       double beta1, double beta2, double eps,
+                       double bias_correction1, double bias_correction2,
+                       double weight_decay, double clip, double grad_scale = 1.0);
+
+    /**
+     * @brief LAMB second pass: p -= step u, recomputing u from the moments.
+     * @param step Learning rate times the trust ratio.
+     */
+    void lambApply(Scalar* params, const Scalar* m, const Scalar* v, size_t n,
+                   double step, double eps, double bias_correction1, double bias_correction2,
+                   double weight_decay);
+
+} // namespace UpdateKernels
@@ -1,12 +1,16 @@
 #pragma once
 
 #include <vector>
+#include "Precision.h"
+#include "MatrixView.h"
 
 /**
  * @file Activations.h
  * @brief Declaration of commonly used activation functions and their derivatives for neural networks.
  *
  * Provides scalar, vector, and batch versions for each activation and its derivative.
+ * The MatrixView batch overloads work in place on a contiguous row-major batch
+ * and split rows across ThreadPool::global().
  */
 
 namespace Activations {
@@ -21,28 +25,28 @@ namespace Activations {
      * @param x Input value.
      * @return Sigmoid of x.
      */
-    double sigmoid(double x);
+    Scalar sigmoid(Scalar x);
 
     /**
      * @brief Computes the ReLU activation for a scalar input.
      * @param x Input value.
      * @return ReLU of x.
      */
-    double relu(double x);
+    Scalar relu(Scalar x);
 
     /**
      * @brief Computes the tanh activation for a scalar input.
      * @param x Input value.
      * @return Tanh of x.
      */
-    double tanh(double x);
+    Scalar tanh(Scalar x);
 
     /**
      * @brief Computes the softplus activation for a scalar input.
      * @param x Input value.
      * @return Softplus of x.
      */
-    double softplus(double x);
+    Scalar softplus(Scalar x);
 
     /** @} */
 
@@ -56,21 +60,21 @@ namespace Activations {
      * @param x Input vector.
      * @return Vector where each element is the sigmoid of the corresponding input.
      */
-    std::vector<double> sigmoid(const std::vector<double>& x);
+    std::vector<Scalar> sigmoid(const std::vector<Scalar>& x);
 
     /**
      * @brief Computes the element-wise ReLU activation for a vector.
      * @param x Input vector.
      * @return Vector where each element is the ReLU of the corresponding input.
      */
-    std::vector<double> relu(const std::vector<double>& x);
+    std::vector<Scalar> relu(const std::vector<Scalar>& x);
 
     /**
      * @brief Computes the element-wise tanh activation for a vector.
      * @param x Input vector.
      * @return Vector where each element is the tanh of the corresponding input.
      */
-    std::vector<double> tanh(const std::vector<double>& x);
+    std::vector<Scalar> tanh(const std::vector<Scalar>& x);
 
     /**
      * @brief Computes the softmax activation for a vector (probability distribution).
@@ -78,7 +82,7 @@ namespace Activations {
      * @param x Input vector.
      * @return Vector representing the softmax probabilities (sum to 1).
      */
-    std::vector<double> softmax(const std::vector<double>& x);
+    std::vector<Scalar> softmax(const std::vector<Scalar>& x);
 
     /** @} */
 
@@ -92,28 +96,28 @@ namespace Activations {
      * @param x Batch of input vectors.
      * @return Batch where each vector is element-wise sigmoid of the input.
      */
-    std::vector<std::vector<double>> sigmoid_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> sigmoid_batch(const std::vector<std::vector<Scalar>>& x);
 
     /**
      * @brief Computes the element-wise ReLU activation for a batch of vectors.
      * @param x Batch of input vectors.
      * @return Batch where each vector is element-wise ReLU of the input.
      */
-    std::vector<std::vector<double>> relu_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> relu_batch(const std::vector<std::vector<Scalar>>& x);
 
     /**
      * @brief Computes the element-wise tanh activation for a batch of vectors.
      * @param x Batch of input vectors.
      * @return Batch where each vector is element-wise tanh of the input.
      */
-    std::vector<std::vector<double>> tanh_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> tanh_batch(const std::vector<std::vector<Scalar>>& x);
 
     /**
      * @brief Computes the softmax activation for a batch of vectors.
      * @param x Batch of input vectors.
      * @return Batch where each vector is the softmax probabilities of the input.
      */
-    std::vector<std::vector<double>> softmax_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> softmax_batch(const std::vector<std::vector<Scalar>>& x);
 
     /** @} */
 
@@ -127,21 +131,21 @@ namespace Activations {
      * @param x Input value.
      * @return Derivative of sigmoid at x.
      */
-    double sigmoid_derivative(double x);
+    Scalar sigmoid_derivative(Scalar x);
 
     /**
      * @brief Computes the derivative of the ReLU activation for a scalar input.
      * @param x Input value.
      * @return Derivative of ReLU at x.
      */
-    double relu_derivative(double x);
+    Scalar relu_derivative(Scalar x);
 
     /**
      * @brief Computes the derivative of the tanh activation for a scalar input.
      * @param x Input value.
      * @return Derivative of tanh at x.
      */
-    double tanh_derivative(double x);
+    Scalar tanh_derivative(Scalar x);
 
     /** @} */
 
@@ -155,21 +159,21 @@ namespace Activations {
      * @param x Input vector.
      * @return Vector of sigmoid derivatives.
      */
-    std::vector<double> sigmoid_derivative(const std::vector<double>& x);
+    std::vector<Scalar> sigmoid_derivative(const std::vector<Scalar>& x);
 
     /**
      * @brief Computes the element-wise derivative of the ReLU activation for a vector.
      * @param x Input vector.
      * @return Vector of ReLU derivatives.
      */
-    std::vector<double> relu_derivative(const std::vector<double>& x);
+    std::vector<Scalar> relu_derivative(const std::vector<Scalar>& x);
 
     /**
      * @brief Computes the element-wise derivative of the tanh activation for a vector.
      * @param x Input vector.
      * @return Vector of tanh derivatives.
      */
-    std::vector<double> tanh_derivative(const std::vector<double>& x);
+    std::vector<Scalar> tanh_derivative(const std::vector<Scalar>& x);
 
     /** @} */
 
@@ -183,21 +187,74 @@ namespace Activations {
      * @param x Batch of input vectors.
      * @return Batch of sigmoid derivatives.
      */
-    std::vector<std::vector<double>> sigmoid_derivative_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> sigmoid_derivative_batch(const std::vector<std::vector<Scalar>>& x);
 
     /**
      * @brief Computes the element-wise derivative of the ReLU activation for a batch of vectors.
      * @param x Batch of input vectors.
      * @return Batch of ReLU derivatives.
      */
-    std::vector<std::vector<double>> relu_derivative_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> relu_derivative_batch(const std::vector<std::vector<Scalar>>& x);
 
     /**
      * @brief Computes the element-wise derivative of the tanh activation for a batch of vectors.
      * @param x Batch of input vectors.
      * @return Batch of tanh derivatives.
      */
-    std::vector<std::vector<double>> tanh_derivative_batch(const std::vector<std::vector<double>>& x);
+    std::vector<std::vector<Scalar>> tanh_derivative_batch(const std::vector<std::vector<Scalar>>& x);
+
+    /** @} */
+
+    /**
+     * @name In-place Batch Kernels (contiguous, row-parallel)
+     * @{
+     */
+
+    /**
+     * @brief Replaces every element of the batch with its sigmoid.
+     * @param x Batch [rows x cols] (row stride >= cols), updated in place.
+     */
+    void sigmoid_batch(MatrixView x);
+
+    /**
+     * @brief Replaces every element of the batch with its ReLU.
+     * @param x Batch [rows x cols], updated in place.
+     */
+    void relu_batch(MatrixView x);
+
+    /**
+     * @brief Replaces every element of the batch with its tanh.
+     * @param x Batch [rows x cols], updated in place.
+     */
+    void tanh_batch(MatrixView x);
+
+    /**
+     * @brief Row-wise softmax in place.
+     *
+     * Each row is processed while cache-resident: max, shifted exp with running
+     * sum, then normalisation. A row whose sum underflows becomes uniform.
+     *
+     * @param x Batch of logits [rows x cols], replaced by probabilities.
+     */
+    void softmax_batch(MatrixView x);
+
+    /**
+     * @brief Replaces every input value with the sigmoid derivative at that value.
+     * @param x Batch of inputs [rows x cols], updated in place.
+     */
+    void sigmoid_derivative_batch(MatrixView x);
+
+    /**
+     * @brief Replaces every input value with the ReLU derivative at that value.
+     * @param x Batch of inputs [rows x cols], updated in place.
+     */
+    void relu_derivative_batch(MatrixView x);
+
+    /**
+     * @brief Replaces every input value with the tanh derivative at that value.
+     * @param x Batch of inputs [rows x cols], updated in place.
+     */
+    void tanh_derivative_batch(MatrixView x);
 
     /** @} */
 
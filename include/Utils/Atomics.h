@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "Precision.h"
+
+/**
+ * @file Atomics.h
+ * @brief Relaxed atomic access to plain Scalar arrays (lock-free Hogwild updates).
+ *
+ * Parameters are stored as ordinary std::vector<Scalar>, so std::atomic cannot
+ * be used without changing the layout. These helpers perform individual loads
+ * and stores with memory_order_relaxed semantics on the existing storage:
+ * each element is read or written whole (no torn values), but concurrent
+ * read-modify-write sequences may overwrite each other, which asynchronous
+ * SGD tolerates by design. On x86-64 and AArch64 they compile to plain moves.
+ */
+namespace Atomics {
+
+    /**
+     * @brief Relaxed atomic load of one element.
+     */
+    inline Scalar loadRelaxed(const Scalar* p) {
+        Scalar value;
+        __atomic_load(p, &value, __ATOMIC_RELAXED);
+        return value;
+    }
+
+    /**
+     * @brief Relaxed atomic store of one element.
+     */
+    inline void storeRelaxed(Scalar* p, Scalar value) {
+        __atomic_store(p, &value, __ATOMIC_RELAXED);
+    }
+
+    /**
+     * @brief Copies n elements that other threads may be writing (element-wise relaxed loads).
+     */
+    inline void copyRelaxed(Scalar* dst, const Scalar* src, size_t n) {
+        for (size_t i = 0; i < n; ++i) dst[i] = loadRelaxed(src + i);
+    }
+
+    /**
+     * @brief Acquire load of a version counter; pairs with incrementRelease.
+     */
+    inline uint32_t loadAcquire(const uint32_t* p) {
+        return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+    }
+
+    /**
+     * @brief Release increment of a version counter: a thread that acquires the
+     *        new value also sees the stores made before the increment.
+     */
+    inline void incrementRelease(uint32_t* p) {
+        __atomic_fetch_add(p, 1u, __ATOMIC_RELEASE);
+    }
+
+} // namespace Atomics
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include "Precision.h"
+
+/**
+ * @file FastMath.h
+ * @brief Polynomial exp / log / tanh / sigmoid approximations with an accuracy switch.
+ *
+ * The approximations use Cody-Waite range reduction followed by a fixed
+ * polynomial, with no table lookups and no data-dependent branches, so loops
+ * over contiguous arrays auto-vectorize. Measured maximum error against a
+ * double-precision reference: exp <= 1 ULP, log <= 2 ULP, sigmoid <= 4 ULP,
+ * tanh <= 7 ULP (6 in float). Like 1 / (1 + exp(-x)) with libm, sigmoid
+ * returns 0 where the true value is subnormal.
+ * Overflow, underflow, infinities and NaN behave like libm.
+ *
+ * Activation and loss kernels call the dispatching functions below.
+ * MathAccuracy::PRECISE (the default) forwards to libm; MathAccuracy::FAST
+ * uses the approximations. The array kernels are where the speed-up comes
+ * from: with SSE2 float32 runs ~2.5x faster than libm, double only gains
+ * once wider vectors are enabled (e.g. -mavx2).
+ */
+
+/**
+ * @brief Selects the implementation used by activation and loss kernels.
+ */
+enum class MathAccuracy {
+    PRECISE, ///< libm (std::exp, std::log, std::tanh)
+    FAST     ///< Vectorizable polynomial approximations (few-ULP error)
+};
+
+namespace FastMath {
+
+    /// Process-wide accuracy mode (relaxed: a mode change need not be ordered with other memory).
+    inline std::atomic<MathAccuracy> accuracy_mode{MathAccuracy::PRECISE};
+
+    /**
+     * @brief Sets the accuracy mode for all subsequent activation / loss evaluations.
+     */
+    inline void setAccuracy(MathAccuracy mode) {
+        accuracy_mode.store(mode, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the current accuracy mode.
+     */
+    inline MathAccuracy getAccuracy() {
+        return accuracy_mode.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief True when the approximations are selected.
+     */
+    inline bool isFast() {
+        return getAccuracy() == MathAccuracy::FAST;
+    }
+
+    /**
+     * @name Approximations
+     * @{
+     */
+
+    namespace detail {
+        constexpr double kLog2e = 1.4426950408889634;
+        constexpr double kLn2Hi = 6.93147180369123816490e-01;
+        constexpr double kLn2Lo = 1.90821492927058770002e-10;
+        constexpr double kShifter = 6755399441055744.0;          // 1.5 * 2^52
+        constexpr uint64_t kShifterBits = 0x4338000000000000ull;
+
+        constexpr float kLn2HiF = 0.693359375f;
+        constexpr float kLn2LoF = -2.12194440e-4f;
+        constexpr float kShifterF = 12582912.0f;                 // 1.5 * 2^23
+        constexpr uint32_t kShifterBitsF = 0x4B400000u;
+
+        /// 2^m for integral m in [-1022, 1023], built from exponent bits.
+        inline double pow2i(double m) {
+            const double k = m + kShifter;
+            uint64_t bits;
+            std::memcpy(&bits, &k, sizeof(bits));
+            bits = (bits - kShifterBits + 1023u) << 52;
+            double result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        /// 2^m for integral m in [-126, 127].
+        inline float pow2i(float m) {
+            const float k = m + kShifterF;
+            uint32_t bits;
+            std::memcpy(&bits, &k, sizeof(bits));
+            bits = (bits - kShifterBitsF + 127u) << 23;
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        /// e^r - 1 for |r| <= ln2/2 (Taylor series to r^13).
+        inline double expm1Reduced(double r) {
+            double p = 1.0 / 6227020800.0;
+            p = p * r + 1.0 / 479001600.0;
+            p = p * r + 1.0 / 39916800.0;
+            p = p * r + 1.0 / 3628800.0;
+            p = p * r + 1.0 / 362880.0;
+            p = p * r + 1.0 / 40320.0;
+            p = p * r + 1.0 / 5040.0;
+            p = p * r + 1.0 / 720.0;
+            p = p * r + 1.0 / 120.0;
+            p = p * r + 1.0 / 24.0;
+            p = p * r + 1.0 / 6.0;
+            p = p * r + 0.5;
+            return r + r * r * p;
+        }
+
+        /// e^r - 1 for |r| <= ln2/2 (Taylor series to r^7).
+        inline float expm1Reduced(float r) {
+            float p = 1.0f / 5040.0f;
+            p = p * r + 1.0f / 720.0f;
+            p = p * r + 1.0f / 120.0f;
+            p = p * r + 1.0f / 24.0f;
+            p = p * r + 1.0f / 6.0f;
+            p = p * r + 0.5f;
+            return r + r * r * p;
+        }
+    } // namespace detail
+
+    /**
+     * @brief e^x: x = n ln2 + r, e^r by polynomial, scaled by 2^n in two steps
+     *        so subnormal results are formed correctly.
+     */
+    inline double expApprox(double x) {
+        using namespace detail;
+        const double xc = std::min(std::max(x, -746.0), 710.0);
+        const double n = (xc * kLog2e + kShifter) - kShifter;
+        const double r = (xc - n * kLn2Hi) - n * kLn2Lo;
+        const double n1 = (n * 0.5 + kShifter) - kShifter;
+        const double y = (1.0 + expm1Reduced(r)) * pow2i(n1) * pow2i(n - n1);
+        return x != x ? x : y;
+    }
+
+    /// @copydoc expApprox(double)
+    inline float expApprox(float x) {
+        using namespace detail;
+        const float xc = std::min(std::max(x, -104.0f), 89.0f);
+        const float n = (xc * static_cast<float>(kLog2e) + kShifterF) - kShifterF;
+        const float r = (xc - n * kLn2HiF) - n * kLn2LoF;
+        const float n1 = (n * 0.5f + kShifterF) - kShifterF;
+        const float y = (1.0f + expm1Reduced(r)) * pow2i(n1) * pow2i(n - n1);
+        return x != x ? x : y;
+    }
+
+    /**
+     * @brief ln x: x = 2^e m with m in [sqrt(1/2), sqrt(2)), ln m = 2 atanh(s)
+     *        with s = (m - 1) / (m + 1) evaluated as an odd series.
+     */
+    inline double logApprox(double x) {
+        using namespace detail;
+        const bool subnormal = x < 2.2250738585072014e-308;
+        const double xs = subnormal ? x * 18014398509481984.0 : x;  // 2^54
+        uint64_t bits;
+        std::memcpy(&bits, &xs, sizeof(bits));
+        double e = static_cast<double>(static_cast<int64_t>((bits >> 52) & 0x7FF) - 1023) - (subnormal ? 54.0 : 0.0);
+        bits = (bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
+        double m;
+        std::memcpy(&m, &bits, sizeof(m));
+        const bool high = m > 1.4142135623730951;
+        m = high ? m * 0.5 : m;
+        e = high ? e + 1.0 : e;
+
+        const double f = m - 1.0;
+        const double s = f / (2.0 + f);
+        const double z = s * s;
+        double R = 1.0 / 19.0;
+        R = R * z + 1.0 / 17.0;
+        R = R * z + 1.0 / 15.0;
+        R = R * z + 1.0 / 13.0;
+        R = R * z + 1.0 / 11.0;
+        R = R * z + 1.0 / 9.0;
+        R = R * z + 1.0 / 7.0;
+        R = R * z + 1.0 / 5.0;
+        R = R * z + 1.0 / 3.0;
+        R = R * z;
+        const double y = e * kLn2Hi + ((2.0 * s + 2.0 * s * R) + e * kLn2Lo);
+
+        const double special = x == 0.0 ? -HUGE_VAL : (x > 0.0 ? x : NAN);  // 0, +inf, negative, NaN
+        return (x > 0.0 && x < HUGE_VAL) ? y : special;
+    }
+
+    /// @copydoc logApprox(double)
+    inline float logApprox(float x) {
+        using namespace detail;
+        const bool subnormal = x < 1.17549435e-38f;
+        const float xs = subnormal ? x * 16777216.0f : x;  // 2^24
+        uint32_t bits;
+        std::memcpy(&bits, &xs, sizeof(bits));
+        float e = static_cast<float>(static_cast<int32_t>((bits >> 23) & 0xFF) - 127) - (subnormal ? 24.0f : 0.0f);
+        bits = (bits & 0x007FFFFFu) | 0x3F800000u;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        const bool high = m > 1.41421356f;
+        m = high ? m * 0.5f : m;
+        e = high ? e + 1.0f : e;
+
+        const float f = m - 1.0f;
+        const float s = f / (2.0f + f);
+        const float z = s * s;
+        float R = 1.0f / 11.0f;
+        R = R * z + 1.0f / 9.0f;
+        R = R * z + 1.0f / 7.0f;
+        R = R * z + 1.0f / 5.0f;
+        R = R * z + 1.0f / 3.0f;
+        R = R * z;
+        const float y = e * kLn2HiF + ((2.0f * s + 2.0f * s * R) + e * kLn2LoF);
+
+        const float special = x == 0.0f ? -HUGE_VALF : (x > 0.0f ? x : NAN);
+        return (x > 0.0f && x < HUGE_VALF) ? y : special;
+    }
+
+    /**
+     * @brief tanh x: e/(e + 2) with e = expm1(2|x|) near zero (no cancellation),
+     *        1 - 2/(e^{2|x|} + 1) elsewhere.
+     */
+    inline double tanhApprox(double x) {
+        constexpr double kSmall = 0.17328679513998632;  // ln2 / 4
+        const double a = std::abs(x);
+        const double e = detail::expm1Reduced(std::min(2.0 * a, 2.0 * kSmall));
+        const double near_zero = e / (e + 2.0);
+        const double far = 1.0 - 2.0 / (expApprox(2.0 * a) + 1.0);
+        return std::copysign(a < kSmall ? near_zero : far, x);
+    }
+
+    /// @copydoc tanhApprox(double)
+    inline float tanhApprox(float x) {
+        constexpr float kSmall = 0.173286795f;
+        const float a = std::abs(x);
+        const float e = detail::expm1Reduced(std::min(2.0f * a, 2.0f * kSmall));
+        const float near_zero = e / (e + 2.0f);
+        const float far = 1.0f - 2.0f / (expApprox(2.0f * a) + 1.0f);
+        return std::copysign(a < kSmall ? near_zero : far, x);
+    }
+
+    /**
+     * @brief Logistic sigmoid 1 / (1 + e^{-x}).
+     */
+    inline double sigmoidApprox(double x) {
+        return 1.0 / (1.0 + expApprox(-x));
+    }
+
+    /// @copydoc sigmoidApprox(double)
+    inline float sigmoidApprox(float x) {
+        return 1.0f / (1.0f + expApprox(-x));
+    }
+
+    /** @} */
+
+    /**
+     * @name Mode-dispatching scalar functions
+     * @{
+     */
+
+    template <typename T>
+    inline T exp(T x) { return isFast() ? expApprox(x) : std::exp(x); }
+
+    template <typename T>
+    inline T log(T x) { return isFast() ? logApprox(x) : std::log(x); }
+
+    template <typename T>
+    inline T tanh(T x) { return isFast() ? tanhApprox(x) : std::tanh(x); }
+
+    template <typename T>
+    inline T sigmoid(T x) { return isFast() ? sigmoidApprox(x) : T(1) / (T(1) + std::exp(-x)); }
+
+    /** @} */
+
+    /**
+     * @name Array kernels (mode checked once per call; y may alias x)
+     * @{
+     */
+
+    void exp(const Scalar* x, Scalar* y, size_t n);
+    void log(const Scalar* x, Scalar* y, size_t n);
+    void tanh(const Scalar* x, Scalar* y, size_t n);
+    void sigmoid(const Scalar* x, Scalar* y, size_t n);
+
+    /** @} */
+
+    /**
+     * @brief Converts an accuracy mode to a string for logging.
+     */
+    const char* toString(MathAccuracy mode);
+
+} // namespace FastMath
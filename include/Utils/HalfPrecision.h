@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include "Precision.h"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file HalfPrecision.h
+ * @brief 16-bit storage formats (bfloat16 / IEEE fp16) used for mixed-precision training.
+ *
+ * Values are only *stored* in 16 bits; all arithmetic is done in Scalar after
+ * decoding. bf16 conversion is a shift and is always done in software. fp16
+ * uses the F16C instructions when the compiler targets them (-mf16c) and a
+ * portable software conversion otherwise.
+ */
+
+/**
+ * @brief Storage format for cached activations and weight copies.
+ */
+enum class StoragePrecision {
+    NATIVE, ///< Store in Scalar (no conversion)
+    BF16,   ///< bfloat16: 8-bit exponent, 7-bit mantissa (fp32 range)
+    FP16    ///< IEEE 754 half: 5-bit exponent, 10-bit mantissa
+};
+
+namespace HalfPrecision {
+
+    /**
+     * @brief Converts a float to bfloat16 with round-to-nearest-even.
+     */
+    inline uint16_t floatToBF16(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+            return static_cast<uint16_t>((bits >> 16) | 0x0040u); // quiet NaN
+        }
+        const uint32_t rounding = 0x7FFFu + ((bits >> 16) & 1u);
+        return static_cast<uint16_t>((bits + rounding) >> 16);
+    }
+
+    /**
+     * @brief Converts a bfloat16 value back to float (exact).
+     */
+    inline float bf16ToFloat(uint16_t value) {
+        const uint32_t bits = static_cast<uint32_t>(value) << 16;
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    /**
+     * @brief Converts a float to IEEE fp16 with round-to-nearest-even.
+     *
+     * Overflow saturates to infinity, values below half the smallest
+     * subnormal flush to signed zero.
+     */
+    inline uint16_t floatToFP16(float value) {
+#if defined(__F16C__)
+        return static_cast<uint16_t>(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+#else
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        const uint32_t abs_bits = bits & 0x7FFFFFFFu;
+
+        if (abs_bits >= 0x7F800000u) {                       // Inf / NaN
+            return static_cast<uint16_t>(sign | (abs_bits > 0x7F800000u ? 0x7E00u : 0x7C00u));
+        }
+        if (abs_bits >= 0x47800000u) {                       // >= 2^16: overflow
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        }
+
+        const uint32_t exponent = abs_bits >> 23;
+        if (exponent < 113) {                                 // fp16 subnormal range
+            if (exponent < 102) return static_cast<uint16_t>(sign);
+            const uint32_t mantissa = (abs_bits & 0x7FFFFFu) | 0x800000u;
+            const uint32_t shift = 126 - exponent;
+            uint32_t result = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (result & 1u))) ++result;
+            return static_cast<uint16_t>(sign | result);
+        }
+
+        uint32_t result = ((exponent - 112) << 10) | ((abs_bits >> 13) & 0x3FFu);
+        const uint32_t remainder = abs_bits & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (result & 1u))) ++result;
+        return static_cast<uint16_t>(sign | result);
+#endif
+    }
+
+    /**
+     * @brief Converts an IEEE fp16 value back to float (exact).
+     */
+    inline float fp16ToFloat(uint16_t value) {
+#if defined(__F16C__)
+        return _cvtsh_ss(value);
+#else
+        const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1Fu;
+        const uint32_t mantissa = value & 0x3FFu;
+
+        uint32_t bits;
+        if (exponent == 0) {
+            if (mantissa == 0) {
+                bits = sign;
+            } else {                                           // subnormal: m * 2^-24
+                const float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+                return sign ? -magnitude : magnitude;
+            }
+        } else if (exponent == 31) {
+            bits = sign | 0x7F800000u | (mantissa << 13);
+        } else {
+            bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+        float result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return result;
+#endif
+    }
+
+    /**
+     * @brief Encodes a single Scalar in the given 16-bit format.
+     */
+    inline uint16_t encode(Scalar value, StoragePrecision precision) {
+        return precision == StoragePrecision::FP16
+            ? floatToFP16(static_cast<float>(value))
+            : floatToBF16(static_cast<float>(value));
+    }
+
+    /**
+     * @brief Decodes a single 16-bit value to Scalar.
+     */
+    inline Scalar decode(uint16_t value, StoragePrecision precision) {
+        return static_cast<Scalar>(precision == StoragePrecision::FP16
+            ? fp16ToFloat(value)
+            : bf16ToFloat(value));
+    }
+
+    /**
+     * @brief Encodes a contiguous Scalar array.
+     * @param src Source values.
+     * @param dst Destination buffer (n elements).
+     * @param n Number of elements.
+     * @param precision BF16 or FP16.
+     */
+    void encode(const Scalar* src, uint16_t* dst, size_t n, StoragePrecision precision);
+
+    /**
+     * @brief Decodes a contiguous 16-bit array to Scalar.
+     * @param src Source values.
+     * @param dst Destination buffer (n elements).
+     * @param n Number of elements.
+     * @param precision BF16 or FP16.
+     */
+    void decode(const uint16_t* src, Scalar* dst, size_t n, StoragePrecision precision);
+
+    /**
+     * @brief Converts storage precision to a human-readable string.
+     */
+    const char* toString(StoragePrecision precision);
+
+} // namespace HalfPrecision
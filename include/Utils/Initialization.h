@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <cstddef>
+#include "Precision.h"
 
 /**
  * @brief Enumeration for various weight initialization methods.
@@ -42,7 +43,7 @@ double clamp(double val, double lo, double hi);
  * @param bias_value Constant value for bias initialization.
  * @return Initialized parameters matrix.
  */
-std::vector<std::vector<double>> initializeParameters(
+std::vector<std::vector<Scalar>> initializeParameters(
     size_t in_features,
     size_t out_features,
     InitMethod method,
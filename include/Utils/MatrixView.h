@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include "Precision.h"
+
+/**
+ * @file MatrixView.h
+ * @brief Non-owning row-major views over contiguous batch buffers.
+ *
+ * Row i starts at data + i * stride; stride >= cols allows padded rows or
+ * a column block of a wider matrix.
+ */
+
+/**
+ * @brief Mutable row-major view [rows x cols] with a row stride.
+ */
+struct MatrixView {
+    Scalar* data = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t stride = 0;
+
+    MatrixView() = default;
+    MatrixView(Scalar* data, size_t rows, size_t cols, size_t stride)
+        : data(data), rows(rows), cols(cols), stride(stride) {
+        if (stride < cols) throw std::invalid_argument("MatrixView: stride smaller than cols");
+    }
+    MatrixView(Scalar* data, size_t rows, size_t cols) : MatrixView(data, rows, cols, cols) {}
+
+    /**
+     * @brief Views a flat buffer as [rows x cols] (buffer.size() must equal rows * cols).
+     */
+    MatrixView(std::vector<Scalar>& buffer, size_t rows, size_t cols) : MatrixView(buffer.data(), rows, cols) {
+        if (buffer.size() != rows * cols) throw std::invalid_argument("MatrixView: buffer size mismatch");
+    }
+
+    Scalar* row(size_t i) const { return data + i * stride; }
+    Scalar& operator()(size_t i, size_t j) const { return data[i * stride + j]; }
+};
+
+/**
+ * @brief Read-only row-major view [rows x cols] with a row stride.
+ */
+struct ConstMatrixView {
+    const Scalar* data = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t stride = 0;
+
+    ConstMatrixView() = default;
+    ConstMatrixView(const Scalar* data, size_t rows, size_t cols, size_t stride)
+        : data(data), rows(rows), cols(cols), stride(stride) {
+        if (stride < cols) throw std::invalid_argument("ConstMatrixView: stride smaller than cols");
+    }
+    ConstMatrixView(const Scalar* data, size_t rows, size_t cols) : ConstMatrixView(data, rows, cols, cols) {}
+    ConstMatrixView(const std::vector<Scalar>& buffer, size_t rows, size_t cols) : ConstMatrixView(buffer.data(), rows, cols) {
+        if (buffer.size() != rows * cols) throw std::invalid_argument("ConstMatrixView: buffer size mismatch");
+    }
+    ConstMatrixView(const MatrixView& view) : data(view.data), rows(view.rows), cols(view.cols), stride(view.stride) {}
+
+    const Scalar* row(size_t i) const { return data + i * stride; }
+    const Scalar& operator()(size_t i, size_t j) const { return data[i * stride + j]; }
+};
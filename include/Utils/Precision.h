@@ -0,0 +1,20 @@
+#pragma once
+
+/**
+ * @file Precision.h
+ * @brief Scalar type used for data, parameters, activations and gradients.
+ *
+ * The numeric core defaults to double precision. Building with
+ * NN_USE_FLOAT32 defined (`make PRECISION=float`) switches the whole network
+ * (Dataset storage, layers, losses and optimizers) to float32, halving
+ * memory traffic and doubling SIMD width.
+ *
+ * Hyperparameters (learning rate, momentum, activation alpha/lambda) and
+ * reported loss values stay double regardless of the selected precision.
+ */
+
+#ifdef NN_USE_FLOAT32
+using Scalar = float;
+#else
+using Scalar = double;
+#endif
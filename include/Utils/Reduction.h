@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include "Precision.h"
+#include "ThreadPool.h"
+
+/**
+ * @file Reduction.h
+ * @brief Deterministic compensated summation for sequential and parallel reductions.
+ *
+ * Reduction::sum splits [0, n) into blocks of a fixed size, sums each block
+ * left to right with Neumaier compensation, then combines the block partials
+ * with a pairwise tree whose shape depends only on the number of blocks.
+ * Blocks may run on any thread of ThreadPool::global(), but every partial
+ * lands in its own slot, so the result is bit-identical for any thread count
+ * (including the serial fallback).
+ */
+namespace Reduction {
+
+    /// Default number of terms per block (independent of the thread count).
+    constexpr size_t kBlockSize = 1024;
+
+    /**
+     * @brief Neumaier (improved Kahan) running sum.
+     *
+     * Tracks the low-order bits lost by each addition, so the error does not
+     * grow with the number of terms. Use it for sequential accumulations such
+     * as the per-epoch loss in Sequential::train.
+     */
+    struct CompensatedSum {
+        double sum = 0.0;
+        double compensation = 0.0;
+
+        void add(double x) {
+            const double t = sum + x;
+            if (std::abs(sum) >= std::abs(x)) compensation += (sum - t) + x;
+            else compensation += (x - t) + sum;
+            sum = t;
+        }
+
+        CompensatedSum& operator+=(double x) {
+            add(x);
+            return *this;
+        }
+
+        double result() const { return sum + compensation; }
+    };
+
+    /**
+     * @brief Pairwise sum of values[0..n) with a fixed split (n / 2) at every level.
+     */
+    double pairwise(const double* values, size_t n);
+
+    /**
+     * @brief Deterministic sum of term(i) for i in [0, n).
+     *
+     * @param n Number of terms.
+     * @param term Callable double(size_t i); called exactly once per index, possibly
+     *             concurrently for different indices (it may write per-index outputs).
+     * @param block Terms per block. Must not depend on the thread count; pick it
+     *              from the problem shape (e.g. fewer rows per block for wide rows).
+     * @return Sum of all terms.
+     */
+    template <typename Term>
+    double sum(size_t n, Term&& term, size_t block = kBlockSize) {
+        if (n == 0) return 0.0;
+        if (block == 0) block = 1;
+        const size_t num_blocks = (n + block - 1) / block;
+        if (num_blocks == 1) {
+            // One block: same result, without going through the pool
+            CompensatedSum acc;
+            for (size_t i = 0; i < n; ++i) acc.add(term(i));
+            return acc.result();
+        }
+
+        std::array<double, 64> local;
+        std::vector<double> heap;
+        double* partials = local.data();
+        if (num_blocks > local.size()) {
+            heap.resize(num_blocks);
+            partials = heap.data();
+        }
+
+        ThreadPool::global().parallelFor(0, num_blocks, [&](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b) {
+                const size_t end = (b + 1) * block < n ? (b + 1) * block : n;
+                CompensatedSum acc;
+                for (size_t i = b * block; i < end; ++i) acc.add(term(i));
+                partials[b] = acc.result();
+            }
+        });
+        return pairwise(partials, num_blocks);
+    }
+
+    /**
+     * @brief Deterministic sum of a contiguous array.
+     */
+    double sum(const Scalar* x, size_t n);
+
+    /**
+     * @brief Deterministic sum of squares of a contiguous array.
+     */
+    double sumSquares(const Scalar* x, size_t n);
+
+} // namespace Reduction
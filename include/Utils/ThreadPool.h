@@ -0,0 +1,99 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <type_traits>
+#include <cstddef>
+
+/**
+ * @file ThreadPool.h
+ * @brief Fixed-size worker pool with a blocking parallel-for.
+ *
+ * parallelFor splits an index range into contiguous chunks; workers and the
+ * calling thread claim chunks from a shared counter until none are left, and
+ * the call returns once every chunk has run. A parallelFor issued from inside
+ * a running chunk executes serially on that thread, so kernels can be nested
+ * without deadlock.
+ */
+class ThreadPool {
+private:
+    /**
+     * @brief Type-erased chunk callback (no allocation per parallelFor).
+     */
+    struct Job {
+        void (*invoke)(void* ctx, size_t begin, size_t end) = nullptr;
+        void* ctx = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        size_t chunk = 1;
+        size_t num_chunks = 0;
+        std::atomic<size_t> next_chunk{0};
+        std::exception_ptr error;     ///< First exception thrown by a chunk
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    std::mutex submit_mutex;          ///< One parallelFor at a time per pool
+    Job job;
+    size_t generation = 0;            ///< Incremented for every submitted job
+    size_t active_workers = 0;        ///< Workers currently inside runChunks()
+    bool stopping = false;
+
+    void workerLoop();
+    void runChunks();
+    void run(void (*invoke)(void*, size_t, size_t), void* ctx, size_t begin, size_t end, size_t grain);
+
+public:
+    /**
+     * @brief Creates a pool.
+     * @param num_threads Total threads including the caller; 0 uses std::thread::hardware_concurrency().
+     */
+    explicit ThreadPool(size_t num_threads = 0);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of threads that execute chunks (workers + caller).
+     */
+    size_t size() const { return workers.size() + 1; }
+
+    /**
+     * @brief Runs f(lo, hi) over disjoint sub-ranges covering [begin, end).
+     *
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param f Callable void(size_t lo, size_t hi); must be safe to run concurrently on disjoint ranges.
+     * @param grain Minimum indices per chunk (runs inline when the range is not larger than one grain).
+     */
+    template <typename F>
+    void parallelFor(size_t begin, size_t end, F&& f, size_t grain = 1) {
+        if (end <= begin) return;
+        using Fn = std::remove_reference_t<F>;
+        run([](void* ctx, size_t lo, size_t hi) { (*static_cast<Fn*>(ctx))(lo, hi); },
+            const_cast<void*>(static_cast<const void*>(&f)), begin, end, grain);
+    }
+
+    /**
+     * @brief Process-wide pool used by the batch kernels, training and inference.
+     *
+     * Lock-free once the pool exists (a single atomic load); only the first
+     * call and setGlobalThreads() take a mutex.
+     */
+    static ThreadPool& global();
+
+    /**
+     * @brief Recreates the global pool with a new thread count (call while no kernels are running).
+     * @param num_threads Total threads; 0 uses hardware_concurrency(), 1 disables threading.
+     */
+    static void setGlobalThreads(size_t num_threads);
+};
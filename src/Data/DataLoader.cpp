@@ -56,3 +56,11 @@ DataLoader::Iterator DataLoader::begin() {
 DataLoader::Iterator DataLoader::end() {
     return Iterator(*this, dataset.rows());
 }
+
+const std::vector<size_t>& DataLoader::getOrder() const {
+    return indices;
+}
+
+size_t DataLoader::numBatches() const {
+    return (dataset.rows() + batch_size - 1) / batch_size;
+}
@@ -9,8 +9,8 @@
 // #include <filesystem>
 
 // Helper: Parse CSV line with optional multi-space handling
-std::vector<double> Dataset::parseCSVLine(const std::string& line, char delimiter, bool multiple_spaces) {
-    std::vector<double> row;
+std::vector<Scalar> Dataset::parseCSVLine(const std::string& line, char delimiter, bool multiple_spaces) {
+    std::vector<Scalar> row;
     std::stringstream ss(line);
     std::string token;
     
@@ -18,13 +18,13 @@ std::vector<double> Dataset::parseCSVLine(const std::string& line, char delimite
         // Handle multiple spaces as single delimiter
         std::istringstream iss(line);
         while (iss >> token) {
-            row.push_back(std::stod(token));
+            row.push_back(static_cast<Scalar>(std::stod(token)));
         }
     } else {
         // Standard delimiter parsing
         while (std::getline(ss, token, delimiter)) {
             if (token.empty()) continue;
-            row.push_back(std::stod(token));
+            row.push_back(static_cast<Scalar>(std::stod(token)));
         }
     }
     return row;
@@ -67,11 +67,11 @@ double Dataset::computePercentile(const std::vector<double>& sorted_data, double
 }
 
 // Constructors
-Dataset::Dataset(const std::vector<std::vector<double>>& data) : data(data) {
+Dataset::Dataset(const std::vector<std::vector<Scalar>>& data) : data(data) {
     validateDimensions();
 }
 
-Dataset::Dataset(std::vector<std::vector<double>>&& data) : data(std::move(data)) {
+Dataset::Dataset(std::vector<std::vector<Scalar>>&& data) : data(std::move(data)) {
     validateDimensions();
 }
 
@@ -110,10 +110,12 @@ void Dataset::loadBinary(const std::string& filename, bool skip_header) {
         data_rows = rows - 1;
     }
     
-    // Resize and read data
-    data.resize(data_rows, std::vector<double>(cols));
+    // Resize and read data (on-disk values are always double)
+    data.resize(data_rows, std::vector<Scalar>(cols));
+    std::vector<double> row_buffer(cols);
     for (size_t i = 0; i < data_rows; ++i) {
-        file.read(reinterpret_cast<char*>(data[i].data()), cols * sizeof(double));
+        file.read(reinterpret_cast<char*>(row_buffer.data()), cols * sizeof(double));
+        std::copy(row_buffer.begin(), row_buffer.end(), data[i].begin());
     }
     
     num_rows = data_rows;
@@ -157,12 +159,14 @@ void Dataset::saveBinary(const std::string& filename, bool write_header) const {
     file.write(reinterpret_cast<const char*>(&rows), sizeof(size_t));
     file.write(reinterpret_cast<const char*>(&cols), sizeof(size_t));
     
-    // Write data rows
+    // Write data rows (on-disk values are always double)
+    std::vector<double> row_buffer(cols);
     for (size_t r = start_row; r < data.size(); ++r) {
         if (data[r].size() != cols) {
             throw std::runtime_error("Inconsistent column count in row " + std::to_string(r));
         }
-        file.write(reinterpret_cast<const char*>(data[r].data()), cols * sizeof(double));
+        std::copy(data[r].begin(), data[r].end(), row_buffer.begin());
+        file.write(reinterpret_cast<const char*>(row_buffer.data()), cols * sizeof(double));
     }
 }
 
@@ -266,8 +270,8 @@ std::pair<Dataset, Dataset> Dataset::splitFeaturesLabels(int label_col) const {
         throw std::out_of_range("Label column index out of bounds");
     }
     
-    std::vector<std::vector<double>> features;
-    std::vector<std::vector<double>> labels;
+    std::vector<std::vector<Scalar>> features;
+    std::vector<std::vector<Scalar>> labels;
     
     for (const auto& row : data) {
         if (row.size() != num_cols) {
@@ -276,7 +280,7 @@ std::pair<Dataset, Dataset> Dataset::splitFeaturesLabels(int label_col) const {
         }
         
         // Extract features (all columns except label)
-        std::vector<double> feat_row;
+        std::vector<Scalar> feat_row;
         for (size_t i = 0; i < row.size(); ++i) {
             if (i != label_col) {
                 feat_row.push_back(row[i]);
@@ -293,7 +297,7 @@ std::pair<Dataset, Dataset> Dataset::splitFeaturesLabels(int label_col) const {
 
 
 Dataset Dataset::selectRows(const std::vector<size_t>& indices) const {
-    std::vector<std::vector<double>> selected;
+    std::vector<std::vector<Scalar>> selected;
     for (auto idx : indices) {
         if (idx < data.size()) {
             selected.push_back(data[idx]);
@@ -374,7 +378,7 @@ std::pair<Dataset, Dataset> Dataset::trainTestSplit(double test_fraction,
 Dataset Dataset::transpose() const {
     if (data.empty()) return Dataset();
     
-    std::vector<std::vector<double>> transposed(num_cols, std::vector<double>(num_rows));
+    std::vector<std::vector<Scalar>> transposed(num_cols, std::vector<Scalar>(num_rows));
     
     for (size_t i = 0; i < num_rows; ++i) {
         for (size_t j = 0; j < num_cols; ++j) {
@@ -399,10 +403,10 @@ Dataset Dataset::reshape(size_t new_rows, size_t new_cols) const {
     Dataset reshaped;
     reshaped.num_rows = new_rows;
     reshaped.num_cols = new_cols;
-    reshaped.data.resize(new_rows, std::vector<double>(new_cols));
+    reshaped.data.resize(new_rows, std::vector<Scalar>(new_cols));
 
     // Flatten existing data (row-major order)
-    std::vector<double> flat_data;
+    std::vector<Scalar> flat_data;
     flat_data.reserve(total_elements);
     for (const auto& row : data) {
         flat_data.insert(flat_data.end(), row.begin(), row.end());
@@ -419,8 +423,8 @@ Dataset Dataset::reshape(size_t new_rows, size_t new_cols) const {
     return reshaped;
 }
 
-std::vector<double> Dataset::flatten() const {
-    std::vector<double> result;
+std::vector<Scalar> Dataset::flatten() const {
+    std::vector<Scalar> result;
     result.reserve(num_rows * num_cols);
     
     for (const auto& row : data) {
@@ -447,7 +451,7 @@ void Dataset::toOneHot() {
     size_t num_classes = static_cast<size_t>(max_label) + 1;
 
     // Create new one-hot encoded data
-    std::vector<std::vector<double>> new_data;
+    std::vector<std::vector<Scalar>> new_data;
     new_data.reserve(num_rows);
     
     for (const auto& row : data) {
@@ -462,7 +466,7 @@ void Dataset::toOneHot() {
         }
         
         // Create one-hot vector
-        std::vector<double> one_hot(num_classes, 0.0);
+        std::vector<Scalar> one_hot(num_classes, 0.0);
         one_hot[label_index] = 1.0;
         new_data.push_back(std::move(one_hot));
     }
@@ -474,7 +478,7 @@ void Dataset::toOneHot() {
 
 
 // Accessors
-const std::vector<std::vector<double>>& Dataset::getData() const { 
+const std::vector<std::vector<Scalar>>& Dataset::getData() const { 
     return data; 
 }
 
@@ -487,12 +491,12 @@ size_t Dataset::cols() const {
 }
 
 // Row access
-const std::vector<double>& Dataset::operator[](size_t index) const {
+const std::vector<Scalar>& Dataset::operator[](size_t index) const {
     if (index >= num_rows) throw std::out_of_range("Index out of range");
     return data[index];
 }
 
-std::vector<double>& Dataset::operator[](size_t index) {
+std::vector<Scalar>& Dataset::operator[](size_t index) {
     if (index >= num_rows) throw std::out_of_range("Index out of range");
     return data[index];
 }
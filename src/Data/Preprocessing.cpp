@@ -1,4 +1,5 @@
 #include "Data/Preprocessing.h"
+#include "Utils/Reduction.h"
 #include <iostream>
 #include <algorithm>
 #include <numeric>
@@ -24,13 +25,22 @@ double median(const std::vector<double>& vals) {
         return (copy[n / 2 - 1] + copy[n / 2]) / 2.0;
 }
 
+// Deterministic compensated column statistics (same result for any thread count)
+double columnSum(const std::vector<double>& vals) {
+    return Reduction::sum(vals.size(), [&](size_t i) { return vals[i]; });
+}
+
+double columnSumSquares(const std::vector<double>& vals) {
+    return Reduction::sum(vals.size(), [&](size_t i) { return vals[i] * vals[i]; });
+}
+
 
 }
 
 namespace Preprocessing {
 
 void standardize(Dataset& dataset, const std::vector<size_t>& columns) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty()) return;
     size_t n_cols = data[0].size();
     std::vector<size_t> targetCols = columns.empty() ? std::vector<size_t>(n_cols) : columns;
@@ -42,8 +52,8 @@ void standardize(Dataset& dataset, const std::vector<size_t>& columns) {
             if (!isMissing(row[col])) colVals.push_back(row[col]);
         if (colVals.empty()) continue;
 
-        double mean = std::accumulate(colVals.begin(), colVals.end(), 0.0) / colVals.size();
-        double sq_sum = std::inner_product(colVals.begin(), colVals.end(), colVals.begin(), 0.0);
+        double mean = columnSum(colVals) / colVals.size();
+        double sq_sum = columnSumSquares(colVals);
         double stddev = std::sqrt(sq_sum / colVals.size() - mean * mean);
         if (stddev == 0) continue;
 
@@ -54,7 +64,7 @@ void standardize(Dataset& dataset, const std::vector<size_t>& columns) {
 }
 
 void minMaxNormalize(Dataset& dataset, const std::vector<size_t>& columns) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty()) return;
     size_t n_cols = data[0].size();
     std::vector<size_t> targetCols = columns.empty() ? std::vector<size_t>(n_cols) : columns;
@@ -65,8 +75,8 @@ void minMaxNormalize(Dataset& dataset, const std::vector<size_t>& columns) {
         double maxVal = std::numeric_limits<double>::lowest();
         for (const auto& row : data)
             if (!isMissing(row[col])) {
-                minVal = std::min(minVal, row[col]);
-                maxVal = std::max(maxVal, row[col]);
+                minVal = std::min<double>(minVal, row[col]);
+                maxVal = std::max<double>(maxVal, row[col]);
             }
         if (minVal == maxVal) continue;
 
@@ -89,14 +99,14 @@ void printMissingValues(const Dataset& dataset) {
 }
 
 void dropRowsWithMissing(Dataset& dataset) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
-    data.erase(std::remove_if(data.begin(), data.end(), [](const std::vector<double>& row) {
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
+    data.erase(std::remove_if(data.begin(), data.end(), [](const std::vector<Scalar>& row) {
         return std::any_of(row.begin(), row.end(), isMissing);
     }), data.end());
 }
 
 void imputeMissing(Dataset& dataset, ImputeStrategy strategy, const std::vector<size_t>& columns) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty()) return;
     size_t n_cols = data[0].size();
     std::vector<size_t> targetCols = columns.empty() ? std::vector<size_t>(n_cols) : columns;
@@ -111,7 +121,7 @@ void imputeMissing(Dataset& dataset, ImputeStrategy strategy, const std::vector<
         double replacement = 0.0;
         switch (strategy) {
             case ImputeStrategy::Mean:
-                replacement = std::accumulate(colVals.begin(), colVals.end(), 0.0) / colVals.size();
+                replacement = columnSum(colVals) / colVals.size();
                 break;
             case ImputeStrategy::Median:
                 replacement = median(colVals);
@@ -131,7 +141,7 @@ void imputeMissing(Dataset& dataset, ImputeStrategy strategy, const std::vector<
 }
 
 void fillMissingWithValue(Dataset& dataset, double value, const std::vector<size_t>& columns) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty()) return;
     size_t n_cols = data[0].size();
     std::vector<size_t> targetCols = columns.empty() ? std::vector<size_t>(n_cols) : columns;
@@ -143,7 +153,7 @@ void fillMissingWithValue(Dataset& dataset, double value, const std::vector<size
 }
 
 void dropOutliers(Dataset& dataset, OutlierMethod method, double threshold, const std::vector<size_t>& columns) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty()) return;
     size_t n_cols = data[0].size();
     std::vector<size_t> targetCols = columns.empty() ? std::vector<size_t>(n_cols) : columns;
@@ -157,8 +167,8 @@ void dropOutliers(Dataset& dataset, OutlierMethod method, double threshold, cons
         if (colVals.size() < 2) continue;
 
         if (method == OutlierMethod::ZScore) {
-            double mean = std::accumulate(colVals.begin(), colVals.end(), 0.0) / colVals.size();
-            double sq_sum = std::inner_product(colVals.begin(), colVals.end(), colVals.begin(), 0.0);
+            double mean = columnSum(colVals) / colVals.size();
+            double sq_sum = columnSumSquares(colVals);
             double stddev = std::sqrt(sq_sum / colVals.size() - mean * mean);
             if (stddev == 0) continue;
 
@@ -187,7 +197,7 @@ void dropOutliers(Dataset& dataset, OutlierMethod method, double threshold, cons
         }
     }
 
-    std::vector<std::vector<double>> filtered;
+    std::vector<std::vector<Scalar>> filtered;
     for (size_t i = 0; i < data.size(); ++i)
         if (!to_remove[i]) filtered.push_back(data[i]);
 
@@ -195,12 +205,12 @@ void dropOutliers(Dataset& dataset, OutlierMethod method, double threshold, cons
 }
 
 void dropColumns(Dataset& dataset, const std::vector<size_t>& columnsToRemove) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty() || columnsToRemove.empty()) return;
     std::set<size_t> columnsSet(columnsToRemove.begin(), columnsToRemove.end());
 
     for (auto& row : data) {
-        std::vector<double> newRow;
+        std::vector<Scalar> newRow;
         for (size_t i = 0; i < row.size(); ++i)
             if (columnsSet.find(i) == columnsSet.end()) newRow.push_back(row[i]);
         row = std::move(newRow);
@@ -208,7 +218,7 @@ void dropColumns(Dataset& dataset, const std::vector<size_t>& columnsToRemove) {
 }
 
 void oneHotEncode(Dataset& dataset, const std::vector<size_t>& categoricalColumns) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     if (data.empty() || categoricalColumns.empty()) return;
     size_t rows = data.size();
     size_t cols = data[0].size();
@@ -228,7 +238,7 @@ void oneHotEncode(Dataset& dataset, const std::vector<size_t>& categoricalColumn
     size_t newCols = cols;
     for (auto c : maxCategories) newCols += c - 1; // remove original cat col, add one-hot cols
 
-    std::vector<std::vector<double>> newData(rows, std::vector<double>(newCols, 0.0));
+    std::vector<std::vector<Scalar>> newData(rows, std::vector<Scalar>(newCols, 0.0));
 
     for (size_t row = 0; row < rows; ++row) {
         size_t new_col_idx = 0;
@@ -250,7 +260,7 @@ void oneHotEncode(Dataset& dataset, const std::vector<size_t>& categoricalColumn
 }
 
 void shuffleRows(Dataset& dataset) {
-    auto& data = const_cast<std::vector<std::vector<double>>&>(dataset.getData());
+    auto& data = const_cast<std::vector<std::vector<Scalar>>&>(dataset.getData());
     std::random_device rd;
     std::mt19937 g(rd());
     std::shuffle(data.begin(), data.end(), g);
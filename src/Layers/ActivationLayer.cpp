@@ -1,6 +1,7 @@
 #include "../../include/Layers/ActivationLayer.h"
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 
 ActivationLayer::ActivationLayer(ActivationType act_type, double alpha, double lambda) 
     : activation_type(act_type), alpha(alpha), lambda(lambda) {
@@ -11,41 +12,91 @@ ActivationLayer::ActivationLayer(ActivationType act_type, double alpha, double l
     }
 }
 
-std::vector<double> ActivationLayer::forward(const std::vector<double>& input) {
-    if (input.empty()) {
+std::vector<Scalar> ActivationLayer::forward(const std::vector<Scalar>& input) {
+    std::vector<Scalar> output = input;
+    forwardInPlace(output);
+    return output;
+}
+
+void ActivationLayer::forwardInPlace(std::vector<Scalar>& x) {
+    forwardInto(x.data(), x.size(), x.data());
+}
+
+void ActivationLayer::forwardInto(const Scalar* input, size_t n, Scalar* output) {
+    if (n == 0) {
         throw std::invalid_argument("ActivationLayer: Input cannot be empty");
     }
-    
-    // Cache input for backward pass
-    input_cache = input;
-    
-    // Apply activation function
-    return applyActivation(input, activation_type, alpha, lambda);
+    cache_size = n;
+
+    if (usesSignMask(activation_type)) {
+        sign_mask.resize(signMaskWords(n));
+        activationForwardMasked(input, output, sign_mask.data(), n, activation_type, alpha);
+    } else {
+        activationForward(input, output, n, activation_type, alpha, lambda);
+        // Cache output for backward pass
+        output_cache.assign(output, output + n);
+    }
 }
 
-std::vector<double> ActivationLayer::backward(const std::vector<double>& grad_output) {
-    if (grad_output.empty()) {
+void ActivationLayer::predictInto(const Scalar* input, size_t n, Scalar* output) const {
+    if (n == 0) {
+        throw std::invalid_argument("ActivationLayer: Input cannot be empty");
+    }
+    activationForward(input, output, n, activation_type, alpha, lambda);
+}
+
+std::vector<Scalar> ActivationLayer::backward(const std::vector<Scalar>& grad_output) {
+    std::vector<Scalar> grad_input = grad_output;
+    backwardInPlace(grad_input);
+    return grad_input;
+}
+
+void ActivationLayer::backwardInPlace(std::vector<Scalar>& grad) {
+    backwardInto(grad.data(), grad.size(), grad.data());
+}
+
+void ActivationLayer::backwardInto(const Scalar* grad_output, size_t n, Scalar* grad_input) {
+    if (n == 0) {
         throw std::invalid_argument("ActivationLayer: Gradient output cannot be empty");
     }
-    if (input_cache.size() != grad_output.size()) {
-        throw std::logic_error("ActivationLayer: Input cache and gradient size mismatch");
+    if (cache_size != n) {
+        throw std::logic_error("ActivationLayer: Cache and gradient size mismatch");
     }
-    
-    // Handle softmax special case (combined with CE loss)
-    if (activation_type == ActivationType::SOFTMAX) {
-        return grad_output;  // Loss function handles derivative
+    if (grad_input != grad_output) std::copy(grad_output, grad_output + n, grad_input);
+
+    // Chain rule: element-wise multiply by the cached derivative
+    if (usesSignMask(activation_type)) {
+        activationBackwardMasked(sign_mask.data(), grad_input, n, activation_type, alpha);
+    } else {
+        activationBackwardFromOutput(output_cache.data(), grad_input, n, activation_type, alpha, lambda);
     }
-    
-    // Compute activation derivative
-    auto deriv = activationDerivative(input_cache, activation_type, alpha, lambda);
-    
-    // Element-wise gradient multiplication (chain rule)
-    std::vector<double> grad_input(grad_output.size());
-    for (size_t i = 0; i < grad_output.size(); ++i) {
-        grad_input[i] = grad_output[i] * deriv[i];
+}
+
+void ActivationLayer::releaseCache() {
+    std::vector<Scalar>().swap(output_cache);
+    std::vector<uint64_t>().swap(sign_mask);
+    cache_size = 0;
+}
+
+void ActivationLayer::recycleCache(CachePool& pool) {
+    pool.give(output_cache);
+    pool.give(sign_mask);
+    cache_size = 0;
+}
+
+void ActivationLayer::adoptCache(CachePool& pool) {
+    if (usesSignMask(activation_type)) {
+        pool.take(sign_mask);
+    } else {
+        pool.take(output_cache);
     }
-    
-    return grad_input;
+}
+
+size_t ActivationLayer::outputSize(size_t input_size) const {
+    if (input_size == 0) {
+        throw std::invalid_argument("ActivationLayer::outputSize: Input cannot be empty");
+    }
+    return input_size;
 }
 
 void ActivationLayer::summary() const {
@@ -62,9 +113,21 @@ void ActivationLayer::summary() const {
         default: 
             break;
     }
-    std::cout << " | Input size: " << input_cache.size() << "\n";
+    std::cout << " | Input size: " << cache_size << "\n";
+}
+
+std::unique_ptr<BaseLayer> ActivationLayer::clone() const {
+    return std::make_unique<ActivationLayer>(*this);
 }
 
 ActivationType ActivationLayer::getActivationType() const {
     return activation_type;
 }
+
+double ActivationLayer::getAlpha() const {
+    return alpha;
+}
+
+double ActivationLayer::getLambda() const {
+    return lambda;
+}
@@ -6,114 +6,137 @@
 
 using namespace std;
 
-vector<double> applyActivation(const vector<double>& x, ActivationType act_type,
-                               double alpha, double lambda) {
-    if (x.empty()) return {};
-    
-    vector<double> result;
-    result.reserve(x.size());
-    
+void activationForward(const Scalar* x, Scalar* y, size_t n, ActivationType act_type,
+                       double alpha, double lambda) {
+    if (n == 0) return;
+
     switch (act_type) {
         case ActivationType::RELU:
-            for (double xi : x) result.push_back(max(0.0, xi));
+            for (size_t i = 0; i < n; ++i) y[i] = max(Scalar(0), x[i]);
             break;
-            
-        case ActivationType::LEAKY_RELU:
-            for (double xi : x) result.push_back((xi > 0) ? xi : alpha * xi);
+
+        case ActivationType::LEAKY_RELU: {
+            const Scalar a = static_cast<Scalar>(alpha);
+            for (size_t i = 0; i < n; ++i) y[i] = (x[i] > 0) ? x[i] : a * x[i];
             break;
-            
+        }
+
         case ActivationType::SIGMOID:
-            for (double xi : x) result.push_back(1.0 / (1.0 + exp(-xi)));
+            FastMath::sigmoid(x, y, n);
             break;
-            
+
         case ActivationType::TANH:
-            for (double xi : x) result.push_back(tanh(xi));
+            FastMath::tanh(x, y, n);
             break;
-            
+
         case ActivationType::LINEAR:
-            result = x;
+            if (y != x) copy(x, x + n, y);
             break;
-            
+
         case ActivationType::SOFTMAX: {
-            double max_elem = *max_element(x.begin(), x.end());
+            const Scalar max_elem = *max_element(x, x + n);
+            for (size_t i = 0; i < n; ++i) y[i] = x[i] - max_elem;
+            FastMath::exp(y, y, n);
             double sum = 0.0;
-            std::vector<double> exps;
-            exps.reserve(x.size());
-            
-            for (double xi : x) {
-                double exp_val = exp(xi - max_elem);
-                exps.push_back(exp_val);
-                sum += exp_val;
-            }
-            
+            for (size_t i = 0; i < n; ++i) sum += y[i];
+
             // Handle near-zero sum case
             if (sum < 1e-15) {
-                double uniform = 1.0 / x.size();
-                result = vector<double>(x.size(), uniform);
+                fill(y, y + n, static_cast<Scalar>(1.0 / n));
             } else {
-                for (double e : exps) result.push_back(e / sum);
+                const double inv_sum = 1.0 / sum;
+                for (size_t i = 0; i < n; ++i) y[i] = static_cast<Scalar>(y[i] * inv_sum);
             }
             break;
         }
-            
+
         case ActivationType::SELU:
-            for (double xi : x) {
-                result.push_back(lambda * ((xi > 0) ? xi : alpha * (exp(xi) - 1)));
+            for (size_t i = 0; i < n; ++i) {
+                y[i] = static_cast<Scalar>(lambda * ((x[i] > 0) ? x[i] : alpha * (FastMath::exp(x[i]) - 1)));
             }
             break;
-            
+
         default:
-            throw invalid_argument("Unsupported activation type in applyActivation");
+            throw invalid_argument("Unsupported activation type in activationForward");
     }
-    return result;
 }
 
-vector<double> activationDerivative(const vector<double>& x, ActivationType act_type,
-                                    double alpha, double lambda) {
-    if (x.empty()) return {};
-    
-    vector<double> deriv;
-    deriv.reserve(x.size());
-    
+void activationForwardMasked(const Scalar* x, Scalar* y, uint64_t* mask, size_t n,
+                             ActivationType act_type, double alpha) {
+    if (!usesSignMask(act_type)) {
+        throw invalid_argument("activationForwardMasked: only ReLU and Leaky ReLU use a sign mask");
+    }
+    const Scalar a = act_type == ActivationType::RELU ? Scalar(0) : static_cast<Scalar>(alpha);
+
+    for (size_t w = 0; w < signMaskWords(n); ++w) {
+        const size_t begin = w * 64;
+        const size_t end = min(begin + 64, n);
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const bool positive = x[i] > 0;
+            bits |= static_cast<uint64_t>(positive) << (i - begin);
+            y[i] = positive ? x[i] : a * x[i];
+        }
+        mask[w] = bits;
+    }
+}
+
+void activationBackwardFromOutput(const Scalar* y, Scalar* grad, size_t n, ActivationType act_type,
+                                  double alpha, double lambda) {
     switch (act_type) {
-        case ActivationType::RELU:
-            for (double xi : x) deriv.push_back((xi > 0) ? 1.0 : 0.0);
-            break;
-            
-        case ActivationType::LEAKY_RELU:
-            for (double xi : x) deriv.push_back((xi > 0) ? 1.0 : alpha);
-            break;
-            
-        case ActivationType::SIGMOID: {
-            for (double xi : x) {
-                double sig = 1.0 / (1.0 + exp(-xi));
-                deriv.push_back(sig * (1 - sig));
-            }
+        case ActivationType::SIGMOID:
+            for (size_t i = 0; i < n; ++i) grad[i] *= y[i] * (1 - y[i]);
             break;
-        }
-            
+
         case ActivationType::TANH:
-            for (double xi : x) {
-                double t = tanh(xi);
-                deriv.push_back(1 - t * t);
-            }
+            for (size_t i = 0; i < n; ++i) grad[i] *= 1 - y[i] * y[i];
             break;
-            
+
         case ActivationType::LINEAR:
-            deriv = vector<double>(x.size(), 1.0);
-            break;
-            
-        case ActivationType::SOFTMAX:
-            throw logic_error("Softmax derivative should be handled with cross-entropy loss");
-            
-        case ActivationType::SELU:
-            for (double xi : x) {
-                deriv.push_back((xi > 0) ? lambda : lambda * alpha * exp(xi));
-            }
+        case ActivationType::SOFTMAX:  // Loss function handles derivative
             break;
-            
+
         default:
-            throw invalid_argument("Unsupported activation type in activationDerivative");
+            for (size_t i = 0; i < n; ++i) grad[i] *= activationDerivativeFromOutput(y[i], act_type, alpha, lambda);
+            break;
+    }
+}
+
+void activationBackwardMasked(const uint64_t* mask, Scalar* grad, size_t n,
+                              ActivationType act_type, double alpha) {
+    if (!usesSignMask(act_type)) {
+        throw invalid_argument("activationBackwardMasked: only ReLU and Leaky ReLU use a sign mask");
+    }
+    const Scalar a = act_type == ActivationType::RELU ? Scalar(0) : static_cast<Scalar>(alpha);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!((mask[i / 64] >> (i % 64)) & 1u)) grad[i] *= a;
+    }
+}
+
+vector<Scalar> applyActivation(const vector<Scalar>& x, ActivationType act_type,
+                               double alpha, double lambda) {
+    vector<Scalar> result(x.size());
+    activationForward(x.data(), result.data(), x.size(), act_type, alpha, lambda);
+    return result;
+}
+
+vector<Scalar> activationDerivative(const vector<Scalar>& x, ActivationType act_type,
+                                    double alpha, double lambda) {
+    if (act_type == ActivationType::SOFTMAX) {
+        throw logic_error("Softmax derivative should be handled with cross-entropy loss");
+    }
+
+    vector<Scalar> deriv(x.size(), Scalar(1));
+    if (usesSignMask(act_type)) {
+        const Scalar a = act_type == ActivationType::RELU ? Scalar(0) : static_cast<Scalar>(alpha);
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (!(x[i] > 0)) deriv[i] = a;
+        }
+    } else {
+        vector<Scalar> y(x.size());
+        activationForward(x.data(), y.data(), x.size(), act_type, alpha, lambda);
+        activationBackwardFromOutput(y.data(), deriv.data(), x.size(), act_type, alpha, lambda);
     }
     return deriv;
 }
@@ -0,0 +1,204 @@
+#include "../../include/Layers/DenseActivationLayer.h"
+#include <stdexcept>
+#include <iostream>
+#include <algorithm>
+
+DenseActivationLayer::DenseActivationLayer(size_t in_features, size_t out_features,
+                                           ActivationType act_type, double alpha, double lambda)
+    : DenseLayer(in_features, out_features), activation_type(act_type), alpha(alpha), lambda(lambda)
+{
+    if (act_type == ActivationType::SOFTMAX) {
+        throw std::invalid_argument("DenseActivationLayer: Softmax cannot be fused");
+    }
+    // Apply standard SELU parameters if using defaults
+    if (act_type == ActivationType::SELU && alpha == 0.01) {
+        this->alpha = 1.67326;
+    }
+}
+
+DenseActivationLayer::DenseActivationLayer(const DenseLayer& dense, ActivationType act_type,
+                                           double alpha, double lambda)
+    : DenseLayer(dense), activation_type(act_type), alpha(alpha), lambda(lambda)
+{
+    if (act_type == ActivationType::SOFTMAX) {
+        throw std::invalid_argument("DenseActivationLayer: Softmax cannot be fused");
+    }
+}
+
+void DenseActivationLayer::activateAndCache(Scalar* z)
+{
+    if (usesSignMask(activation_type)) {
+        sign_mask.resize(signMaskWords(output_size));
+        activationForwardMasked(z, z, sign_mask.data(), output_size, activation_type, alpha);
+    } else {
+        activationForward(z, z, output_size, activation_type, alpha, lambda);
+        output_cache.assign(z, z + output_size);
+    }
+    forward_cached = true;
+}
+
+void DenseActivationLayer::computeDelta(const Scalar* grad_output)
+{
+    delta.assign(grad_output, grad_output + output_size);
+    if (usesSignMask(activation_type)) {
+        activationBackwardMasked(sign_mask.data(), delta.data(), output_size, activation_type, alpha);
+    } else {
+        activationBackwardFromOutput(output_cache.data(), delta.data(), output_size, activation_type, alpha, lambda);
+    }
+}
+
+std::vector<Scalar> DenseActivationLayer::forward(const std::vector<Scalar>& input)
+{
+    std::vector<Scalar> output(output_size);
+    forwardInto(input.data(), input.size(), output.data());
+    return output;
+}
+
+void DenseActivationLayer::forwardInto(const Scalar* input, size_t n, Scalar* output)
+{
+    if (n != input_size) {
+        throw std::invalid_argument("DenseActivationLayer::forward: Input size mismatch. Expected " +
+                                    std::to_string(input_size) + ", got " +
+                                    std::to_string(n));
+    }
+    if (!isInitialized()) {
+        throw std::runtime_error("DenseActivationLayer::forward: Parameters not initialized");
+    }
+
+    if (storage_precision != StoragePrecision::NATIVE) {
+        // 16-bit path: dense kernel, then activation over the (cache-resident) output
+        forwardKernel(input, output);
+        activateAndCache(output);
+        return;
+    }
+
+    input_cache.assign(input, input + input_size);
+
+    // z = Wx + b, then the activation epilogue runs over the still-hot output
+    const Scalar* biases = biasData();
+    for (size_t i = 0; i < output_size; ++i) {
+        const Scalar* row = weightRow(i);
+        Scalar sum = 0.0;
+        for (size_t j = 0; j < input_size; ++j) {
+            sum += row[j] * input[j];
+        }
+        output[i] = sum + biases[i];
+    }
+    activateAndCache(output);
+}
+
+void DenseActivationLayer::predictInto(const Scalar* input, size_t n, Scalar* output) const
+{
+    DenseLayer::predictInto(input, n, output);
+    activationForward(output, output, output_size, activation_type, alpha, lambda);
+}
+
+void DenseActivationLayer::predictBatch(ConstMatrixView input, MatrixView output) const
+{
+    DenseLayer::predictBatch(input, output);
+    for (size_t r = 0; r < output.rows; ++r) {
+        activationForward(output.row(r), output.row(r), output_size, activation_type, alpha, lambda);
+    }
+}
+
+std::vector<Scalar> DenseActivationLayer::backward(const std::vector<Scalar>& grad_output)
+{
+    std::vector<Scalar> grad_input(input_size);
+    backwardInto(grad_output.data(), grad_output.size(), grad_input.data());
+    return grad_input;
+}
+
+void DenseActivationLayer::backwardInto(const Scalar* grad_output, size_t n, Scalar* grad_input)
+{
+    if (n != output_size) {
+        throw std::invalid_argument("DenseActivationLayer::backward: Gradient size mismatch. Expected " +
+                                    std::to_string(output_size) + ", got " +
+                                    std::to_string(n));
+    }
+    // The native path reads input_cache directly; the 16-bit kernel checks its own cache
+    if (!forward_cached ||
+        (storage_precision == StoragePrecision::NATIVE && input_cache.size() != input_size)) {
+        throw std::logic_error("DenseActivationLayer::backward: Forward pass not cached");
+    }
+
+    computeDelta(grad_output);
+    if (storage_precision != StoragePrecision::NATIVE) {
+        backwardKernel(delta.data(), grad_input);
+        return;
+    }
+
+    // One sweep over each weight row: input gradient, weight and bias gradients
+    Scalar* grad_biases = gradBiasData();
+    std::fill(grad_input, grad_input + input_size, Scalar(0));
+    for (size_t i = 0; i < output_size; ++i) {
+        const Scalar d = delta[i];
+        const Scalar* row = weightRow(i);
+        Scalar* grad_row = gradWeightRow(i);
+        for (size_t j = 0; j < input_size; ++j) {
+            grad_input[j] += row[j] * d;
+            grad_row[j] += d * input_cache[j];
+        }
+        grad_biases[i] += d;
+    }
+}
+
+void DenseActivationLayer::summary() const
+{
+    const size_t total_params = (input_size * output_size) + output_size;
+    std::cout << "Dense+" << activationTypeToString(activation_type) << " Layer (fused): "
+              << input_size << " -> " << output_size
+              << " | Parameters: " << total_params << " ("
+              << input_size * output_size << " weights, "
+              << output_size << " biases)";
+    if (storage_precision != StoragePrecision::NATIVE) {
+        std::cout << " | Storage: " << HalfPrecision::toString(storage_precision);
+    }
+    std::cout << "\n";
+}
+
+std::unique_ptr<BaseLayer> DenseActivationLayer::clone() const {
+    return std::make_unique<DenseActivationLayer>(*this);
+}
+
+void DenseActivationLayer::releaseCache() {
+    DenseLayer::releaseCache();
+    std::vector<Scalar>().swap(output_cache);
+    std::vector<uint64_t>().swap(sign_mask);
+    std::vector<Scalar>().swap(delta);
+    forward_cached = false;
+}
+
+void DenseActivationLayer::recycleCache(CachePool& pool) {
+    DenseLayer::recycleCache(pool);
+    pool.give(output_cache);
+    pool.give(sign_mask);
+    pool.give(delta);
+    forward_cached = false;
+}
+
+void DenseActivationLayer::adoptCache(CachePool& pool) {
+    DenseLayer::adoptCache(pool);
+    if (usesSignMask(activation_type)) {
+        pool.take(sign_mask);
+    } else {
+        pool.take(output_cache);
+    }
+    pool.take(delta);
+}
+
+void DenseActivationLayer::setStoragePrecision(StoragePrecision precision) {
+    DenseLayer::setStoragePrecision(precision);
+    forward_cached = false;
+}
+
+ActivationType DenseActivationLayer::getActivationType() const {
+    return activation_type;
+}
+
+double DenseActivationLayer::getAlpha() const {
+    return alpha;
+}
+
+double DenseActivationLayer::getLambda() const {
+    return lambda;
+}
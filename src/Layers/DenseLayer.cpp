@@ -1,8 +1,10 @@
 #include "../../include/Layers/DenseLayer.h"
+#include "../../include/Layers/ParameterRegistry.h"
 #include <stdexcept>
 #include <iostream>
 #include <iomanip>
 #include <cmath> // For fabs
+#include <algorithm>
 
 // Constructor with enhanced validation
 DenseLayer::DenseLayer(size_t in_features, size_t out_features, bool init_params)
@@ -13,23 +15,24 @@ DenseLayer::DenseLayer(size_t in_features, size_t out_features, bool init_params
         throw std::invalid_argument("DenseLayer: Input and output features must be > 0");
     }
 
-    // Initialize gradient storage
-    grad_weights.resize(output_size, std::vector<double>(input_size, 0.0));
-    grad_biases.resize(output_size, 0.0);
+    // Zeroed [weights | biases] and gradients in one allocation each
+    parameters = ParameterStorage(output_size * input_size + output_size);
 
-    // Initialize parameters if requested
-    if (init_params)
-    {
-        weights.resize(output_size, std::vector<double>(input_size, 0.0));
-        biases.resize(output_size, 0.0);
-    }
+    // Zero parameters count as initialized if requested
+    weights_initialized = init_params;
+    biases_initialized = init_params;
 }
 
 // Weight initialization - removed redundant bias_value parameter
 void DenseLayer::initializeWeights(InitMethod method, unsigned int seed,
                                    double a, double b, double sparsity, double constant_value)
 {
-    weights = initializeParameters(input_size, output_size, method, seed, a, b, sparsity, constant_value);
+    const auto values = initializeParameters(input_size, output_size, method, seed, a, b, sparsity, constant_value);
+    for (size_t i = 0; i < output_size; ++i) {
+        std::copy(values[i].begin(), values[i].end(), weightRow(i));
+    }
+    weights_initialized = true;
+    refreshLowPrecisionWeights();
 }
 
 // Bias initialization with constant_value parameter
@@ -44,11 +47,12 @@ void DenseLayer::initializeBiases(InitMethod method, unsigned int seed,
         throw std::runtime_error("Bias initialization returned incorrect dimensions");
     }
     
-    biases = temp[0];
+    std::copy(temp[0].begin(), temp[0].end(), biasData());
+    biases_initialized = true;
 }
 
 // Forward pass with bounds checking
-std::vector<double> DenseLayer::forward(const std::vector<double> &input)
+std::vector<Scalar> DenseLayer::forward(const std::vector<Scalar> &input)
 {
     if (input.size() != input_size) {
         throw std::invalid_argument("DenseLayer::forward: Input size mismatch. Expected " + 
@@ -56,30 +60,165 @@ std::vector<double> DenseLayer::forward(const std::vector<double> &input)
                                     std::to_string(input.size()));
     }
 
-    if (weights.empty() || biases.empty()) {
+    if (!isInitialized()) {
         throw std::runtime_error("DenseLayer::forward: Parameters not initialized");
     }
 
-    // Cache input for backward pass
-    input_cache = input;
-
     // Pre-allocate output
-    std::vector<double> output(output_size, 0.0);
+    std::vector<Scalar> output(output_size, 0.0);
+    forwardKernel(input.data(), output.data());
+    return output;
+}
+
+void DenseLayer::forwardInto(const Scalar* input, size_t n, Scalar* output)
+{
+    if (n != input_size) {
+        throw std::invalid_argument("DenseLayer::forward: Input size mismatch. Expected " +
+                                    std::to_string(input_size) + ", got " + std::to_string(n));
+    }
+    if (!isInitialized()) {
+        throw std::runtime_error("DenseLayer::forward: Parameters not initialized");
+    }
+    forwardKernel(input, output);
+}
+
+// y = Wx + b on raw buffers
+void DenseLayer::forwardKernel(const Scalar* input, Scalar* output)
+{
+    const Scalar* biases = biasData();
+    if (storage_precision != StoragePrecision::NATIVE) {
+        // Cache input in 16-bit form, compute with decoded weight rows
+        input_cache_lowp.resize(input_size);
+        HalfPrecision::encode(input, input_cache_lowp.data(), input_size, storage_precision);
+        for (size_t i = 0; i < output_size; ++i) {
+            HalfPrecision::decode(&weights_lowp[i * input_size], decode_buffer.data(),
+                                  input_size, storage_precision);
+            Scalar sum = 0.0;
+            for (size_t j = 0; j < input_size; ++j) {
+                sum += decode_buffer[j] * input[j];
+            }
+            output[i] = sum + biases[i];
+        }
+        return;
+    }
+
+    // Cache input for backward pass
+    input_cache.assign(input, input + input_size);
 
     // Optimized computation: y = Wx + b
     for (size_t i = 0; i < output_size; ++i) {
-        double sum = 0.0;
+        const Scalar* row = weightRow(i);
+        Scalar sum = 0.0;
         for (size_t j = 0; j < input_size; ++j) {
-            sum += weights[i][j] * input[j];
+            sum += row[j] * input[j];
         }
         output[i] = sum + biases[i];
     }
+}
 
-    return output;
+// Inference path: reads weights only, so concurrent calls are safe
+void DenseLayer::predictInto(const Scalar* input, size_t n, Scalar* output) const
+{
+    if (n != input_size) {
+        throw std::invalid_argument("DenseLayer::predict: Input size mismatch. Expected " +
+                                    std::to_string(input_size) + ", got " + std::to_string(n));
+    }
+    if (!isInitialized()) {
+        throw std::runtime_error("DenseLayer::predict: Parameters not initialized");
+    }
+
+    const Scalar* biases = biasData();
+    if (storage_precision != StoragePrecision::NATIVE) {
+        // Decode weights element by element instead of through the shared decode_buffer
+        for (size_t i = 0; i < output_size; ++i) {
+            const uint16_t* row = &weights_lowp[i * input_size];
+            Scalar sum = 0.0;
+            for (size_t j = 0; j < input_size; ++j) {
+                sum += HalfPrecision::decode(row[j], storage_precision) * input[j];
+            }
+            output[i] = sum + biases[i];
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < output_size; ++i) {
+        const Scalar* row = weightRow(i);
+        Scalar sum = 0.0;
+        for (size_t j = 0; j < input_size; ++j) {
+            sum += row[j] * input[j];
+        }
+        output[i] = sum + biases[i];
+    }
+}
+
+// Blocked inference: each weight row is loaded (or decoded) once per block of rows
+void DenseLayer::predictBatch(ConstMatrixView input, MatrixView output) const
+{
+    if (input.cols != input_size || output.cols != output_size || output.rows != input.rows) {
+        throw std::invalid_argument("DenseLayer::predictBatch: Expected [rows x " + std::to_string(input_size) +
+                                    "] -> [rows x " + std::to_string(output_size) + "]");
+    }
+    if (!isInitialized()) {
+        throw std::runtime_error("DenseLayer::predict: Parameters not initialized");
+    }
+
+    const Scalar* biases = biasData();
+    // 16-bit weights are decoded a bounded block of columns at a time into a
+    // stack buffer; the row sums carry over between blocks in output, so the
+    // additions happen in the same order as with one full-row pass
+    constexpr size_t kDecodeBlock = 512;
+    Scalar decoded[kDecodeBlock];
+    const bool low_precision = storage_precision != StoragePrecision::NATIVE;
+    const size_t block = low_precision ? kDecodeBlock : input_size;
+
+    for (size_t i = 0; i < output_size; ++i) {
+        for (size_t r = 0; r < input.rows; ++r) output(r, i) = 0.0;
+
+        for (size_t j0 = 0; j0 < input_size; j0 += block) {
+            const size_t n = std::min(block, input_size - j0);
+            const Scalar* w = decoded;
+            if (low_precision) {
+                HalfPrecision::decode(&weights_lowp[i * input_size + j0], decoded, n, storage_precision);
+            } else {
+                w = weightRow(i) + j0;
+            }
+
+            // Four rows at a time: every weight load feeds four independent sums
+            size_t r = 0;
+            for (; r + 4 <= input.rows; r += 4) {
+                const Scalar* x0 = input.row(r) + j0;
+                const Scalar* x1 = input.row(r + 1) + j0;
+                const Scalar* x2 = input.row(r + 2) + j0;
+                const Scalar* x3 = input.row(r + 3) + j0;
+                Scalar s0 = output(r, i), s1 = output(r + 1, i), s2 = output(r + 2, i), s3 = output(r + 3, i);
+                for (size_t j = 0; j < n; ++j) {
+                    const Scalar wj = w[j];
+                    s0 += wj * x0[j];
+                    s1 += wj * x1[j];
+                    s2 += wj * x2[j];
+                    s3 += wj * x3[j];
+                }
+                output(r, i) = s0;
+                output(r + 1, i) = s1;
+                output(r + 2, i) = s2;
+                output(r + 3, i) = s3;
+            }
+            for (; r < input.rows; ++r) {
+                const Scalar* x = input.row(r) + j0;
+                Scalar sum = output(r, i);
+                for (size_t j = 0; j < n; ++j) {
+                    sum += w[j] * x[j];
+                }
+                output(r, i) = sum;
+            }
+        }
+
+        for (size_t r = 0; r < input.rows; ++r) output(r, i) += biases[i];
+    }
 }
 
 // Backward pass with gradient computation
-std::vector<double> DenseLayer::backward(const std::vector<double> &grad_output)
+std::vector<Scalar> DenseLayer::backward(const std::vector<Scalar> &grad_output)
 {
     if (grad_output.size() != output_size) {
         throw std::invalid_argument("DenseLayer::backward: Gradient size mismatch. Expected " + 
@@ -87,38 +226,303 @@ std::vector<double> DenseLayer::backward(const std::vector<double> &grad_output)
                                     std::to_string(grad_output.size()));
     }
 
+    std::vector<Scalar> grad_input(input_size, 0.0);
+    backwardKernel(grad_output.data(), grad_input.data());
+    return grad_input;
+}
+
+void DenseLayer::backwardInto(const Scalar* grad_output, size_t n, Scalar* grad_input)
+{
+    if (n != output_size) {
+        throw std::invalid_argument("DenseLayer::backward: Gradient size mismatch. Expected " +
+                                    std::to_string(output_size) + ", got " + std::to_string(n));
+    }
+    backwardKernel(grad_output, grad_input);
+}
+
+// Input and parameter gradients on raw buffers
+void DenseLayer::backwardKernel(const Scalar* grad_output, Scalar* grad_input)
+{
+    if (storage_precision != StoragePrecision::NATIVE) {
+        backwardLowPrecision(grad_output, grad_input);
+        return;
+    }
+
     if (input_cache.empty()) {
         throw std::logic_error("DenseLayer::backward: Forward pass not cached");
     }
 
     // Compute input gradient: dL/dx = W^T * dL/dy
-    std::vector<double> grad_input(input_size, 0.0);
+    const Scalar* weights = weightRow(0);
+    std::fill(grad_input, grad_input + input_size, Scalar(0));
     for (size_t j = 0; j < input_size; ++j) {
         for (size_t i = 0; i < output_size; ++i) {
-            grad_input[j] += weights[i][j] * grad_output[i];
+            grad_input[j] += weights[i * input_size + j] * grad_output[i];
         }
     }
 
     // Accumulate parameter gradients
+    Scalar* grad_biases = gradBiasData();
     for (size_t i = 0; i < output_size; ++i) {
         // Weight gradients: dL/dW = dL/dy * x^T
+        Scalar* grad_row = gradWeightRow(i);
         for (size_t j = 0; j < input_size; ++j) {
-            grad_weights[i][j] += grad_output[i] * input_cache[j];
+            grad_row[j] += grad_output[i] * input_cache[j];
         }
         // Bias gradients: dL/db = dL/dy
         grad_biases[i] += grad_output[i];
     }
+}
 
-    return grad_input;
+// Backward pass reading 16-bit weights and cached inputs
+void DenseLayer::backwardLowPrecision(const Scalar* grad_output, Scalar* grad_input)
+{
+    if (input_cache_lowp.size() != input_size) {
+        throw std::logic_error("DenseLayer::backward: Forward pass not cached");
+    }
+
+    // Decode cached input once, then accumulate dL/dW = dL/dy * x^T
+    decoded_input.resize(input_size);
+    HalfPrecision::decode(input_cache_lowp.data(), decoded_input.data(), input_size, storage_precision);
+    const Scalar* input = decoded_input.data();
+
+    Scalar* grad_biases = gradBiasData();
+    std::fill(grad_input, grad_input + input_size, Scalar(0));
+    for (size_t i = 0; i < output_size; ++i) {
+        const Scalar g = grad_output[i];
+        HalfPrecision::decode(&weights_lowp[i * input_size], decode_buffer.data(),
+                              input_size, storage_precision);
+        Scalar* grad_row = gradWeightRow(i);
+        for (size_t j = 0; j < input_size; ++j) {
+            grad_input[j] += decode_buffer[j] * g;
+            grad_row[j] += g * input[j];
+        }
+        grad_biases[i] += g;
+    }
+}
+
+size_t DenseLayer::outputSize(size_t n) const
+{
+    if (n != input_size) {
+        throw std::invalid_argument("DenseLayer::outputSize: Expected input size " +
+                                    std::to_string(input_size) + ", got " + std::to_string(n));
+    }
+    return output_size;
+}
+
+// Forward pass over a subset of output rows (sampled softmax)
+void DenseLayer::forwardSampled(const std::vector<Scalar> &input, const std::vector<size_t> &rows,
+                                std::vector<Scalar> &output)
+{
+    if (input.size() != input_size) {
+        throw std::invalid_argument("DenseLayer::forwardSampled: Input size mismatch. Expected " +
+                                    std::to_string(input_size) + ", got " +
+                                    std::to_string(input.size()));
+    }
+    if (!isInitialized()) {
+        throw std::runtime_error("DenseLayer::forwardSampled: Parameters not initialized");
+    }
+
+    const bool low_precision = storage_precision != StoragePrecision::NATIVE;
+    if (low_precision) {
+        input_cache_lowp.resize(input_size);
+        HalfPrecision::encode(input.data(), input_cache_lowp.data(), input_size, storage_precision);
+    } else {
+        input_cache.assign(input.begin(), input.end());
+    }
+
+    const Scalar* biases = biasData();
+    output.resize(rows.size());
+    for (size_t k = 0; k < rows.size(); ++k) {
+        const size_t i = rows[k];
+        if (i >= output_size) {
+            throw std::out_of_range("DenseLayer::forwardSampled: Row index out of range");
+        }
+        const Scalar* w = weightRow(i);
+        if (low_precision) {
+            HalfPrecision::decode(&weights_lowp[i * input_size], decode_buffer.data(),
+                                  input_size, storage_precision);
+            w = decode_buffer.data();
+        }
+        Scalar sum = 0.0;
+        for (size_t j = 0; j < input_size; ++j) {
+            sum += w[j] * input[j];
+        }
+        output[k] = sum + biases[i];
+    }
+}
+
+// Backward pass scattering into the sampled rows only
+void DenseLayer::backwardSampled(const std::vector<Scalar> &grad_output, const std::vector<size_t> &rows,
+                                 std::vector<Scalar> &grad_input)
+{
+    if (grad_output.size() != rows.size()) {
+        throw std::invalid_argument("DenseLayer::backwardSampled: Gradient size mismatch. Expected " +
+                                    std::to_string(rows.size()) + ", got " +
+                                    std::to_string(grad_output.size()));
+    }
+
+    const bool low_precision = storage_precision != StoragePrecision::NATIVE;
+    const Scalar* input = input_cache.data();
+    if (low_precision) {
+        if (input_cache_lowp.size() != input_size) {
+            throw std::logic_error("DenseLayer::backwardSampled: Forward pass not cached");
+        }
+        decoded_input.resize(input_size);
+        HalfPrecision::decode(input_cache_lowp.data(), decoded_input.data(), input_size, storage_precision);
+        input = decoded_input.data();
+    } else if (input_cache.size() != input_size) {
+        throw std::logic_error("DenseLayer::backwardSampled: Forward pass not cached");
+    }
+
+    Scalar* grad_biases = gradBiasData();
+    grad_input.assign(input_size, 0.0);
+    for (size_t k = 0; k < rows.size(); ++k) {
+        const size_t i = rows[k];
+        if (i >= output_size) {
+            throw std::out_of_range("DenseLayer::backwardSampled: Row index out of range");
+        }
+        const Scalar g = grad_output[k];
+        const Scalar* w = weightRow(i);
+        if (low_precision) {
+            HalfPrecision::decode(&weights_lowp[i * input_size], decode_buffer.data(),
+                                  input_size, storage_precision);
+            w = decode_buffer.data();
+        }
+        Scalar* grad_row = gradWeightRow(i);
+        for (size_t j = 0; j < input_size; ++j) {
+            grad_input[j] += w[j] * g;
+            grad_row[j] += g * input[j];
+        }
+        grad_biases[i] += g;
+    }
 }
 
 // Reset accumulated gradients
 void DenseLayer::clearGradients()
 {
-    for (auto &row : grad_weights) {
-        std::fill(row.begin(), row.end(), 0.0);
+    std::fill(parameters.grads(), parameters.grads() + parameters.size(), Scalar(0));
+}
+
+// Scale accumulated gradients (loss-scaling support)
+void DenseLayer::scaleGradients(double factor)
+{
+    Scalar* grads = parameters.grads();
+    for (size_t i = 0; i < parameters.size(); ++i) grads[i] *= factor;
+}
+
+// Weights, then the biases; the registry splits them into parallel chunks
+void DenseLayer::registerParameters(ParameterRegistry& registry)
+{
+    if (!isInitialized()) return;
+
+    ParameterGroup group;
+    group.layer = this;
+    group.weight_count = output_size * input_size;
+    group.spans.push_back({weightRow(0), gradWeightRow(0), group.weight_count, 0});
+    group.spans.push_back({biasData(), gradBiasData(), output_size, group.weight_count});
+    registry.addGroup(std::move(group));
+}
+
+void DenseLayer::parametersChanged()
+{
+    refreshLowPrecisionWeights();
+}
+
+// Sparse steps write a few rows; re-encode just those (biases have no 16-bit copy)
+void DenseLayer::spansChanged(const std::vector<ParameterSpan>& spans)
+{
+    if (storage_precision == StoragePrecision::NATIVE || !weights_initialized) return;
+    const size_t weight_count = output_size * input_size;
+    if (weights_lowp.size() != weight_count) {
+        refreshLowPrecisionWeights();
+        return;
+    }
+    for (const ParameterSpan& span : spans) {
+        if (span.offset >= weight_count) continue;
+        HalfPrecision::encode(span.values, weights_lowp.data() + span.offset, span.size, storage_precision);
     }
-    std::fill(grad_biases.begin(), grad_biases.end(), 0.0);
+}
+
+void DenseLayer::bindParameters(Scalar* values, Scalar* grads)
+{
+    parameters.bind(values, grads);
+}
+
+bool DenseLayer::isInitialized() const
+{
+    return weights_initialized && biases_initialized;
+}
+
+// Detect overflowed gradients
+bool DenseLayer::hasFiniteGradients() const
+{
+    const Scalar* grads = parameters.grads();
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (!std::isfinite(grads[i])) return false;
+    }
+    return true;
+}
+
+// Drop the backward caches; forwardKernel / forwardSampled size them again
+void DenseLayer::releaseCache()
+{
+    std::vector<Scalar>().swap(input_cache);
+    std::vector<uint16_t>().swap(input_cache_lowp);
+    std::vector<Scalar>().swap(decoded_input);
+}
+
+void DenseLayer::recycleCache(CachePool& pool)
+{
+    pool.give(input_cache);
+    pool.give(input_cache_lowp);
+    pool.give(decoded_input);
+}
+
+// Only the cache the current storage format fills
+void DenseLayer::adoptCache(CachePool& pool)
+{
+    if (storage_precision == StoragePrecision::NATIVE) {
+        pool.take(input_cache);
+    } else {
+        pool.take(input_cache_lowp);
+        pool.take(decoded_input);
+    }
+}
+
+// Switch between native and 16-bit storage
+void DenseLayer::setStoragePrecision(StoragePrecision precision)
+{
+    storage_precision = precision;
+    if (precision == StoragePrecision::NATIVE) {
+        // The last forward cached its input in 16 bits: nothing to backward from
+        std::vector<Scalar>().swap(input_cache);
+        std::vector<uint16_t>().swap(weights_lowp);
+        std::vector<uint16_t>().swap(input_cache_lowp);
+        std::vector<Scalar>().swap(decode_buffer);
+        std::vector<Scalar>().swap(decoded_input);
+        return;
+    }
+    // No cached input in either format until the next forward pass sizes
+    // input_cache_lowp, so backward before it throws "not cached"
+    std::vector<Scalar>().swap(input_cache);
+    std::vector<uint16_t>().swap(input_cache_lowp);
+    decode_buffer.assign(input_size, 0.0);
+    decoded_input.assign(input_size, 0.0);
+    refreshLowPrecisionWeights();
+}
+
+StoragePrecision DenseLayer::getStoragePrecision() const {
+    return storage_precision;
+}
+
+// Re-encode 16-bit weights from the master copy
+void DenseLayer::refreshLowPrecisionWeights()
+{
+    if (storage_precision == StoragePrecision::NATIVE || !weights_initialized) return;
+    // Rows are contiguous: one encode over the whole matrix
+    weights_lowp.resize(output_size * input_size);
+    HalfPrecision::encode(weightRow(0), weights_lowp.data(), output_size * input_size, storage_precision);
 }
 
 // Display layer summary
@@ -128,13 +532,22 @@ void DenseLayer::summary() const
     std::cout << "Dense Layer: " << input_size << " -> " << output_size
               << " | Parameters: " << total_params << " ("
               << input_size * output_size << " weights, "
-              << output_size << " biases)\n";
+              << output_size << " biases)";
+    if (storage_precision != StoragePrecision::NATIVE) {
+        std::cout << " | Storage: " << HalfPrecision::toString(storage_precision);
+    }
+    std::cout << "\n";
+}
+
+std::unique_ptr<BaseLayer> DenseLayer::clone() const
+{
+    return std::make_unique<DenseLayer>(*this);
 }
 
 // Print weights with formatting
 void DenseLayer::printWeights() const
 {
-    if (weights.empty()) {
+    if (!weights_initialized) {
         std::cout << "Weights not initialized" << std::endl;
         return;
     }
@@ -143,7 +556,7 @@ void DenseLayer::printWeights() const
     for (size_t i = 0; i < output_size; ++i) {
         std::cout << "  [";
         for (size_t j = 0; j < input_size; ++j) {
-            std::cout << std::fixed << std::setprecision(5) << std::setw(8) << weights[i][j];
+            std::cout << std::fixed << std::setprecision(5) << std::setw(8) << weightRow(i)[j];
             if (j < input_size - 1) std::cout << ", ";
         }
         std::cout << "]\n";
@@ -153,11 +566,12 @@ void DenseLayer::printWeights() const
 // Print biases with formatting
 void DenseLayer::printBiases() const
 {
-    if (biases.empty()) {
+    if (!biases_initialized) {
         std::cout << "Biases not initialized" << std::endl;
         return;
     }
 
+    const Scalar* biases = biasData();
     std::cout << "Biases [" << output_size << "]:\n  [";
     for (size_t i = 0; i < output_size; ++i) {
         std::cout << std::fixed << std::setprecision(5) << std::setw(8) << biases[i];
@@ -172,24 +586,28 @@ size_t DenseLayer::getParameterCount() const {
 }
 
 // Getters with const correctness
-const std::vector<std::vector<double>>& DenseLayer::getGradWeights() const {
-    return grad_weights;
+ConstMatrixView DenseLayer::getGradWeights() const {
+    return ConstMatrixView(gradWeightRow(0), output_size, input_size);
 }
 
-const std::vector<double>& DenseLayer::getGradBiases() const {
-    return grad_biases;
+const Scalar* DenseLayer::getGradBiases() const {
+    return gradBiasData();
 }
 
-const std::vector<std::vector<double>>& DenseLayer::getWeights() const {
-    return weights;
+size_t DenseLayer::getOutputSize() const {
+    return output_size;
 }
 
-const std::vector<double>& DenseLayer::getBiases() const {
-    return biases;
+ConstMatrixView DenseLayer::getWeights() const {
+    return ConstMatrixView(weightRow(0), output_size, input_size);
 }
 
-// Setters with enhanced validation
-void DenseLayer::setWeights(std::vector<std::vector<double>>& new_weights)
+const Scalar* DenseLayer::getBiases() const {
+    return biasData();
+}
+
+// Setters with enhanced validation; values are copied into the layer's storage
+void DenseLayer::setWeights(std::vector<std::vector<Scalar>>& new_weights)
 {
     if (new_weights.size() != output_size) {
         throw std::invalid_argument("DenseLayer::setWeights: Row count mismatch");
@@ -199,34 +617,28 @@ void DenseLayer::setWeights(std::vector<std::vector<double>>& new_weights)
             throw std::invalid_argument("DenseLayer::setWeights: Column count mismatch");
         }
     }
-    weights = new_weights;
+    for (size_t i = 0; i < output_size; ++i) {
+        std::copy(new_weights[i].begin(), new_weights[i].end(), weightRow(i));
+    }
+    weights_initialized = true;
+    refreshLowPrecisionWeights();
 }
 
-void DenseLayer::setWeights(std::vector<std::vector<double>>&& new_weights)
+void DenseLayer::setWeights(std::vector<std::vector<Scalar>>&& new_weights)
 {
-    if (new_weights.size() != output_size) {
-        throw std::invalid_argument("DenseLayer::setWeights: Row count mismatch");
-    }
-    for (const auto& row : new_weights) {
-        if (row.size() != input_size) {
-            throw std::invalid_argument("DenseLayer::setWeights: Column count mismatch");
-        }
-    }
-    weights = std::move(new_weights);
+    setWeights(new_weights);
 }
 
-void DenseLayer::setBiases(std::vector<double>& new_biases)  // copy
+void DenseLayer::setBiases(std::vector<Scalar>& new_biases)  // copy
 {
     if (new_biases.size() != output_size) {
         throw std::invalid_argument("DenseLayer::setBiases: Size mismatch");
     }
-    biases = new_biases;
+    std::copy(new_biases.begin(), new_biases.end(), biasData());
+    biases_initialized = true;
 }
 
-void DenseLayer::setBiases(std::vector<double>&& new_biases)  // move
+void DenseLayer::setBiases(std::vector<Scalar>&& new_biases)  // move
 {
-    if (new_biases.size() != output_size) {
-        throw std::invalid_argument("DenseLayer::setBiases: Size mismatch");
-    }
-    biases = std::move(new_biases);
+    setBiases(new_biases);
 }
@@ -0,0 +1,166 @@
+#include "../../include/Layers/ParameterRegistry.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+ParameterRegistry::ParameterRegistry(const std::vector<BaseLayer*>& layers)
+{
+    for (BaseLayer* layer : layers) add(*layer);
+}
+
+void ParameterRegistry::clear()
+{
+    groups.clear();
+    total_count = 0;
+    flat_values = nullptr;
+    flat_grads = nullptr;
+    contiguous = true;
+}
+
+void ParameterRegistry::add(BaseLayer& layer)
+{
+    layer.registerParameters(*this);
+}
+
+void ParameterRegistry::addGroup(ParameterGroup group)
+{
+    size_t count = 0;
+    std::vector<ParameterSpan> chunks;
+    for (const ParameterSpan& span : group.spans) {
+        if (span.offset != count) {
+            throw std::invalid_argument("ParameterRegistry::addGroup: Spans must be contiguous and ordered");
+        }
+
+        // Track whether the whole registry is still one run of memory
+        if (total_count + count == 0) {
+            flat_values = span.values;
+            flat_grads = span.grads;
+        } else if (span.values != flat_values + total_count + count ||
+                   span.grads != flat_grads + total_count + count) {
+            contiguous = false;
+        }
+
+        for (size_t begin = 0; begin < span.size; begin += kChunkSize) {
+            const size_t n = std::min(kChunkSize, span.size - begin);
+            chunks.push_back({span.values + begin, span.grads + begin, n, span.offset + begin});
+        }
+        count += span.size;
+    }
+    if (chunks.empty() || group.weight_count > count) {
+        throw std::invalid_argument("ParameterRegistry::addGroup: Invalid group");
+    }
+
+    // About kChunkSize values per parallel task
+    group.spans = std::move(chunks);
+    const size_t average = std::max<size_t>(1, count / group.spans.size());
+    group.count = count;
+    group.grain = average < kChunkSize ? kChunkSize / average : 1;
+    total_count += count;
+    groups.push_back(std::move(group));
+}
+
+void ParameterRegistry::addRows(const ParameterGroup& full, size_t row_size, const std::vector<size_t>& rows)
+{
+    const size_t num_rows = row_size == 0 ? 0 : full.weight_count / row_size;
+    if (full.spans.empty() || full.spans.front().offset != 0 || num_rows * row_size != full.weight_count ||
+        full.count != full.weight_count + num_rows) {
+        throw std::invalid_argument("ParameterRegistry::addRows: Group is not [weights row-major | biases]");
+    }
+    // Weights and biases were registered as one span each, so both are contiguous from their first chunk
+    const auto bias_span = std::find_if(full.spans.begin(), full.spans.end(),
+                                        [&](const ParameterSpan& span) { return span.offset >= full.weight_count; });
+    if (bias_span == full.spans.end() || bias_span->offset != full.weight_count) {
+        throw std::invalid_argument("ParameterRegistry::addRows: Group is not [weights row-major | biases]");
+    }
+    const ParameterSpan& weights = full.spans.front();
+
+    ParameterGroup group;
+    group.layer = full.layer;
+    group.count = full.count;
+    group.weight_count = full.weight_count;
+    group.partial = true;
+    group.spans.reserve(2 * rows.size());
+    for (size_t row : rows) {
+        if (row >= num_rows) {
+            throw std::invalid_argument("ParameterRegistry::addRows: Row index out of range");
+        }
+        const size_t offset = row * row_size;
+        group.spans.push_back({weights.values + offset, weights.grads + offset, row_size, offset});
+    }
+    // Bias spans after all weight spans, as reduce() expects
+    for (size_t row : rows) {
+        group.spans.push_back({bias_span->values + row, bias_span->grads + row, 1, full.weight_count + row});
+    }
+
+    const size_t values = rows.size() * (row_size + 1);
+    const size_t average = std::max<size_t>(1, values / std::max<size_t>(1, group.spans.size()));
+    group.grain = average < kChunkSize ? kChunkSize / average : 1;
+    total_count += values;
+    contiguous = false;
+    groups.push_back(std::move(group));
+}
+
+void ParameterRegistry::zeroGradients() const
+{
+    if (isContiguous()) {
+        ThreadPool::global().parallelFor(0, total_count, [&](size_t lo, size_t hi) {
+            std::fill(flat_grads + lo, flat_grads + hi, Scalar(0));
+        }, kChunkSize);
+        return;
+    }
+    for (const ParameterGroup& group : groups) {
+        ThreadPool::global().parallelFor(0, group.spans.size(), [&](size_t lo, size_t hi) {
+            for (size_t s = lo; s < hi; ++s) {
+                std::fill(group.spans[s].grads, group.spans[s].grads + group.spans[s].size, Scalar(0));
+            }
+        }, group.grain);
+    }
+}
+
+void ParameterRegistry::scaleGradients(double factor) const
+{
+    if (isContiguous()) {
+        for (size_t i = 0; i < total_count; ++i) flat_grads[i] *= factor;
+        return;
+    }
+    for (const ParameterGroup& group : groups) {
+        for (const ParameterSpan& span : group.spans) {
+            for (size_t i = 0; i < span.size; ++i) span.grads[i] *= factor;
+        }
+    }
+}
+
+bool ParameterRegistry::gradientsFinite() const
+{
+    if (isContiguous()) {
+        for (size_t i = 0; i < total_count; ++i) {
+            if (!std::isfinite(flat_grads[i])) return false;
+        }
+        return true;
+    }
+    for (const ParameterGroup& group : groups) {
+        for (const ParameterSpan& span : group.spans) {
+            for (size_t i = 0; i < span.size; ++i) {
+                if (!std::isfinite(span.grads[i])) return false;
+            }
+        }
+    }
+    return true;
+}
+
+double ParameterRegistry::gradientSquaredNorm() const
+{
+    if (isContiguous()) return Reduction::sumSquares(flat_grads, total_count);
+
+    // Per-group sums are deterministic reductions; combining them in order keeps it so
+    Reduction::CompensatedSum squared;
+    for (const ParameterGroup& group : groups) {
+        const auto sums = reduce(group, [](Scalar*, Scalar* grads, size_t n, size_t) {
+            double sq = 0.0;
+            for (size_t i = 0; i < n; ++i) sq += static_cast<double>(grads[i]) * grads[i];
+            return sq;
+        });
+        squared += sums.first + sums.second;
+    }
+    return squared.result();
+}
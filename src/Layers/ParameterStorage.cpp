@@ -0,0 +1,55 @@
+#include "../../include/Layers/ParameterStorage.h"
+#include <algorithm>
+#include <stdexcept>
+
+ParameterStorage::ParameterStorage(size_t count)
+    : owned_values(count, 0.0), owned_grads(count, 0.0),
+      values_(owned_values.data()), grads_(owned_grads.data()), count(count)
+{
+}
+
+ParameterStorage::ParameterStorage(const ParameterStorage& other)
+    : owned_values(other.values_, other.values_ + other.count),
+      owned_grads(other.grads_, other.grads_ + other.count),
+      values_(owned_values.data()), grads_(owned_grads.data()), count(other.count)
+{
+}
+
+ParameterStorage& ParameterStorage::operator=(const ParameterStorage& other)
+{
+    if (this != &other) {
+        std::vector<Scalar> values(other.values_, other.values_ + other.count);
+        std::vector<Scalar> grads(other.grads_, other.grads_ + other.count);
+        owned_values.swap(values);
+        owned_grads.swap(grads);
+        values_ = owned_values.data();
+        grads_ = owned_grads.data();
+        count = other.count;
+    }
+    return *this;
+}
+
+void ParameterStorage::bind(Scalar* values, Scalar* grads)
+{
+    if ((values == nullptr) != (grads == nullptr)) {
+        throw std::invalid_argument("ParameterStorage::bind: Values and gradients must both be set or both be null");
+    }
+
+    if (values == nullptr) {
+        // Back to owned storage
+        if (!isBound()) return;
+        owned_values.assign(values_, values_ + count);
+        owned_grads.assign(grads_, grads_ + count);
+        values_ = owned_values.data();
+        grads_ = owned_grads.data();
+        return;
+    }
+
+    if (values != values_) std::copy(values_, values_ + count, values);
+    if (grads != grads_) std::copy(grads_, grads_ + count, grads);
+    values_ = values;
+    grads_ = grads;
+    // The owned copy is stale from now on
+    std::vector<Scalar>().swap(owned_values);
+    std::vector<Scalar>().swap(owned_grads);
+}
@@ -4,12 +4,13 @@
  */
 
 #include "../../../include/Metrics/Losses.h"
+#include "../../../include/Utils/Reduction.h"
 #include <stdexcept>
 #include <cmath>
 
 namespace Losses {
 
-double mse_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred) {
+double mse_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred) {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MSE: Size mismatch or empty vector.");
     double sum = 0.0;
@@ -18,39 +19,43 @@ double mse_loss(const std::vector<double>& y_true, const std::vector<double>& y_
     return sum / (2 * y_true.size());
 }
 
-std::vector<double> mse_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred) {
+std::vector<Scalar> mse_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred) {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MSE Derivative: Size mismatch or empty vector.");
-    std::vector<double> grad(y_true.size());
+    std::vector<Scalar> grad(y_true.size());
     for (size_t i = 0; i < y_true.size(); ++i)
         grad[i] = (y_pred[i] - y_true[i]) / y_true.size() ;
     return grad;
 }
 
-double mse_loss_batch(const std::vector<std::vector<double>>& y_true, 
-                      const std::vector<std::vector<double>>& y_pred) {
+double mse_loss_batch(const std::vector<std::vector<Scalar>>& y_true, 
+                      const std::vector<std::vector<Scalar>>& y_pred) {
     if(y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MSE Batch: Size mismatch or empty batch.");
     
     size_t total_elements = 0;
-    double total = 0.0;
     
     for(size_t i = 0; i < y_true.size(); ++i) {
         if(y_true[i].empty() || y_true[i].size() != y_pred[i].size())
             throw std::invalid_argument("MSE Batch: Size mismatch at index " + std::to_string(i));
         
         total_elements += y_true[i].size();
-        
-        for(size_t j = 0; j < y_true[i].size(); ++j)
-            total += std::pow(y_true[i][j] - y_pred[i][j], 2);
     }
+
+    // Deterministic row reduction (same result for any thread count)
+    const double total = Reduction::sum(y_true.size(), [&](size_t i) {
+        double row_sum = 0.0;
+        for(size_t j = 0; j < y_true[i].size(); ++j)
+            row_sum += std::pow(y_true[i][j] - y_pred[i][j], 2);
+        return row_sum;
+    });
     
     return total / (2 * total_elements);  
 }
 
-std::vector<std::vector<double>> mse_derivative_batch(
-    const std::vector<std::vector<double>>& y_true, 
-    const std::vector<std::vector<double>>& y_pred) 
+std::vector<std::vector<Scalar>> mse_derivative_batch(
+    const std::vector<std::vector<Scalar>>& y_true, 
+    const std::vector<std::vector<Scalar>>& y_pred) 
 {
     if(y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MSE Derivative Batch: Size mismatch or empty batch.");
@@ -61,13 +66,13 @@ std::vector<std::vector<double>> mse_derivative_batch(
         total_elements += vec.size();
     }
     
-    std::vector<std::vector<double>> grads(y_true.size());
+    std::vector<std::vector<Scalar>> grads(y_true.size());
     
     for(size_t i = 0; i < y_true.size(); ++i) {
         if(y_true[i].empty() || y_true[i].size() != y_pred[i].size())
             throw std::invalid_argument("MSE Derivative Batch: Size mismatch at index " + std::to_string(i));
         
-        std::vector<double> grad_i(y_true[i].size());
+        std::vector<Scalar> grad_i(y_true[i].size());
         
         for(size_t j = 0; j < y_true[i].size(); ++j) {
             grad_i[j] = (y_pred[i][j] - y_true[i][j]) / total_elements;
@@ -4,12 +4,13 @@
  */
 
 #include "../../../include/Metrics/Losses.h"
+#include "../../../include/Utils/Reduction.h"
 #include <stdexcept>
 #include <cmath>
 
 namespace Losses {
 
-double mae_loss(const std::vector<double>& y_true, const std::vector<double>& y_pred) {
+double mae_loss(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred) {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MAE: Size mismatch or empty vector.");
     double sum = 0.0;
@@ -18,10 +19,10 @@ double mae_loss(const std::vector<double>& y_true, const std::vector<double>& y_
     return sum / (y_true.size());
 }
 
-std::vector<double> mae_derivative(const std::vector<double>& y_true, const std::vector<double>& y_pred) {
+std::vector<Scalar> mae_derivative(const std::vector<Scalar>& y_true, const std::vector<Scalar>& y_pred) {
     if (y_true.size() != y_pred.size() || y_true.empty())
         throw std::invalid_argument("MAE Derivative: Size mismatch or empty vector.");
-    std::vector<double> grad(y_true.size());
+    std::vector<Scalar> grad(y_true.size());
     for (size_t i = 0; i < y_true.size(); ++i) {
         grad[i] = (y_pred[i] > y_true[i]) ? 1.0 : (y_pred[i] < y_true[i]) ? -1.0 : 0.0;
         grad[i] /= y_true.size();
@@ -29,12 +30,11 @@ std::vector<double> mae_derivative(const std::vector<double>& y_true, const std:
     return grad;
 }
 
-double mae_loss_batch(const std::vector<std::vector<double>>& y_true, 
-                      const std::vector<std::vector<double>>& y_pred) {
+double mae_loss_batch(const std::vector<std::vector<Scalar>>& y_true, 
+                      const std::vector<std::vector<Scalar>>& y_pred) {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MAE Batch: Size mismatch or empty batch.");
     
-    double total_abs = 0.0;
     size_t total_elements = 0;
     
     for (size_t i = 0; i < y_true.size(); ++i) {
@@ -42,16 +42,22 @@ double mae_loss_batch(const std::vector<std::vector<double>>& y_true,
             throw std::invalid_argument("MAE Batch: Size mismatch at index " + std::to_string(i));
         
         total_elements += y_true[i].size();
-        for (size_t j = 0; j < y_true[i].size(); ++j)
-            total_abs += std::abs(y_true[i][j] - y_pred[i][j]);
     }
+
+    // Deterministic row reduction (same result for any thread count)
+    const double total_abs = Reduction::sum(y_true.size(), [&](size_t i) {
+        double row_sum = 0.0;
+        for (size_t j = 0; j < y_true[i].size(); ++j)
+            row_sum += std::abs(y_true[i][j] - y_pred[i][j]);
+        return row_sum;
+    });
     
     return total_abs / total_elements;
 }
 
-std::vector<std::vector<double>> mae_derivative_batch(
-    const std::vector<std::vector<double>>& y_true,
-    const std::vector<std::vector<double>>& y_pred) 
+std::vector<std::vector<Scalar>> mae_derivative_batch(
+    const std::vector<std::vector<Scalar>>& y_true,
+    const std::vector<std::vector<Scalar>>& y_pred) 
 {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("MAE Derivative Batch: Size mismatch or empty batch.");
@@ -62,13 +68,13 @@ std::vector<std::vector<double>> mae_derivative_batch(
         total_elements += vec.size();
     }
     
-    std::vector<std::vector<double>> grads(y_true.size());
+    std::vector<std::vector<Scalar>> grads(y_true.size());
     
     for (size_t i = 0; i < y_true.size(); ++i) {
         if (y_true[i].empty() || y_true[i].size() != y_pred[i].size())
             throw std::invalid_argument("MAE Derivative Batch: Size mismatch at index " + std::to_string(i));
         
-        std::vector<double> grad_i(y_true[i].size());  // Correct size
+        std::vector<Scalar> grad_i(y_true[i].size());  // Correct size
         
         for (size_t j = 0; j < y_true[i].size(); ++j) {
             grad_i[j] = (y_pred[i] > y_true[i]) ? 1.0 : 
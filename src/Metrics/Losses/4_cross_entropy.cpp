@@ -1,4 +1,6 @@
 #include "Metrics/Losses.h"
+#include "Utils/FastMath.h"
+#include "Utils/Reduction.h"
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
@@ -10,17 +12,16 @@ static inline double clamp(double v, double lo, double hi) {
     return (v < lo) ? lo : (hi < v) ? hi : v;
 }
 
-static inline std::vector<double> softmax(const std::vector<double>& logits) {
+static inline std::vector<Scalar> softmax(const std::vector<Scalar>& logits) {
     if (logits.empty()) return {};
     
-    std::vector<double> exps(logits.size());
-    double max_logit = *std::max_element(logits.begin(), logits.end());
+    std::vector<Scalar> exps(logits.size());
+    const Scalar max_logit = *std::max_element(logits.begin(), logits.end());
+    for (size_t i = 0; i < logits.size(); ++i) exps[i] = logits[i] - max_logit;
+    FastMath::exp(exps.data(), exps.data(), exps.size());
 
     double sum = 0.0;
-    for (size_t i = 0; i < logits.size(); ++i) {
-        exps[i] = std::exp(logits[i] - max_logit);
-        sum += exps[i];
-    }
+    for (Scalar e : exps) sum += e;
 
     // Avoid division by zero
     if (sum < 1e-15) sum = 1e-15;
@@ -31,35 +32,129 @@ static inline std::vector<double> softmax(const std::vector<double>& logits) {
     return exps;
 }
 
-double cross_entropy_loss(const std::vector<double>& y_true, 
-                          const std::vector<double>& y_pred, 
+/**
+ * Softmax cross entropy of one row: loss = logsumexp(z) - sum_j y_j z_j.
+ * y_true == nullptr means a one-hot target at `label`. When grad is non-null it
+ * receives (softmax(z) - y) * grad_scale; grad may alias z.
+ */
+static double softmax_cross_entropy_row(const Scalar* z, size_t n, const Scalar* y_true, size_t label,
+                                        Scalar* grad, Scalar grad_scale) {
+    const Scalar max_logit = *std::max_element(z, z + n);
+
+    // Target term before z can be overwritten by an aliased grad
+    double target_dot = 0.0;
+    double target_mass = 1.0;
+    if (y_true) {
+        target_mass = 0.0;
+        for (size_t j = 0; j < n; ++j) {
+            target_dot += y_true[j] * (z[j] - max_logit);
+            target_mass += y_true[j];
+        }
+    } else {
+        target_dot = z[label] - max_logit;
+    }
+
+    double sum = 0.0;
+    if (grad) {
+        for (size_t j = 0; j < n; ++j) grad[j] = z[j] - max_logit;
+        FastMath::exp(grad, grad, n);
+        for (size_t j = 0; j < n; ++j) sum += grad[j];
+    } else {
+        for (size_t j = 0; j < n; ++j) sum += FastMath::exp(z[j] - max_logit);
+    }
+    const double log_sum = FastMath::log(sum);  // sum >= 1 (the max term is exp(0))
+
+    if (grad) {
+        const Scalar scale = static_cast<Scalar>(grad_scale / sum);
+        if (y_true) {
+            for (size_t j = 0; j < n; ++j) grad[j] = grad[j] * scale - y_true[j] * grad_scale;
+        } else {
+            for (size_t j = 0; j < n; ++j) grad[j] *= scale;
+            grad[label] -= grad_scale;
+        }
+    }
+    return target_mass * log_sum - target_dot;
+}
+
+/**
+ * Runs softmax_cross_entropy_row over all rows in parallel and returns the mean loss.
+ */
+template <typename RowTarget>
+static double softmax_cross_entropy_rows(ConstMatrixView logits, MatrixView grad, RowTarget target) {
+    const bool with_grad = grad.data != nullptr;
+    if (with_grad && (grad.rows != logits.rows || grad.cols != logits.cols))
+        throw std::invalid_argument("Softmax Cross Entropy: Gradient shape mismatch.");
+
+    const Scalar grad_scale = static_cast<Scalar>(1.0 / logits.rows);
+    const size_t grain = std::max<size_t>(1, 16384 / logits.cols);
+
+    // Fixed-shape reduction: same total for any thread count
+    const double total_loss = Reduction::sum(logits.rows, [&](size_t i) {
+        const Scalar* y_row = nullptr;
+        size_t label = 0;
+        target(i, y_row, label);
+        return softmax_cross_entropy_row(logits.row(i), logits.cols, y_row, label,
+                                         with_grad ? grad.row(i) : nullptr, grad_scale);
+    }, grain);
+
+    return total_loss / logits.rows;
+}
+
+double softmax_cross_entropy_batch(ConstMatrixView logits, ConstMatrixView y_true, MatrixView grad) {
+    if (logits.rows == 0 || logits.cols == 0)
+        throw std::invalid_argument("Softmax Cross Entropy: Empty batch.");
+    if (y_true.rows != logits.rows || y_true.cols != logits.cols)
+        throw std::invalid_argument("Softmax Cross Entropy: Target shape mismatch.");
+
+    return softmax_cross_entropy_rows(logits, grad, [&](size_t i, const Scalar*& y_row, size_t&) {
+        y_row = y_true.row(i);
+    });
+}
+
+double sparse_softmax_cross_entropy_batch(ConstMatrixView logits, const std::vector<size_t>& labels, MatrixView grad) {
+    if (logits.rows == 0 || logits.cols == 0)
+        throw std::invalid_argument("Sparse Softmax Cross Entropy: Empty batch.");
+    if (labels.size() != logits.rows)
+        throw std::invalid_argument("Sparse Softmax Cross Entropy: Label count mismatch.");
+    for (size_t i = 0; i < labels.size(); ++i) {
+        if (labels[i] >= logits.cols)
+            throw std::invalid_argument("Sparse Softmax Cross Entropy: Label out of range at index " + std::to_string(i));
+    }
+
+    return softmax_cross_entropy_rows(logits, grad, [&](size_t i, const Scalar*&, size_t& label) {
+        label = labels[i];
+    });
+}
+
+double cross_entropy_loss(const std::vector<Scalar>& y_true, 
+                          const std::vector<Scalar>& y_pred, 
                           bool from_logits) {
     if (y_true.size() != y_pred.size() || y_true.empty())
         throw std::invalid_argument("Cross Entropy: Size mismatch or empty vector.");
     
     const double eps = 1e-7;
-    std::vector<double> probs = from_logits ? softmax(y_pred) : y_pred;
+    std::vector<Scalar> probs = from_logits ? softmax(y_pred) : y_pred;
 
     double loss = 0.0;
     for (size_t i = 0; i < y_true.size(); ++i) {
         double p = clamp(probs[i], eps, 1.0 - eps);
-        loss -= y_true[i] * std::log(p);
+        loss -= y_true[i] * FastMath::log(p);
     }
 
     return loss;  // Removed averaging by class count
 }
 
-std::vector<double> cross_entropy_derivative(const std::vector<double>& y_true, 
-                                             const std::vector<double>& y_pred, 
+std::vector<Scalar> cross_entropy_derivative(const std::vector<Scalar>& y_true, 
+                                             const std::vector<Scalar>& y_pred, 
                                              bool from_logits) {
     if (y_true.size() != y_pred.size() || y_true.empty())
         throw std::invalid_argument("Cross Entropy Derivative: Size mismatch or empty vector.");
     
     const double eps = 1e-7;
-    std::vector<double> grad(y_true.size());
+    std::vector<Scalar> grad(y_true.size());
     
     if (from_logits) {
-        std::vector<double> probs = softmax(y_pred);
+        std::vector<Scalar> probs = softmax(y_pred);
         for (size_t i = 0; i < y_true.size(); ++i) {
             grad[i] = probs[i] - y_true[i];     // No averaging on number of classes
         }
@@ -73,39 +168,51 @@ std::vector<double> cross_entropy_derivative(const std::vector<double>& y_true,
     return grad;
 }
 
-double cross_entropy_loss_batch(const std::vector<std::vector<double>>& y_true, 
-                                const std::vector<std::vector<double>>& y_pred, 
+double cross_entropy_loss_batch(const std::vector<std::vector<Scalar>>& y_true, 
+                                const std::vector<std::vector<Scalar>>& y_pred, 
                                 bool from_logits) {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("Cross Entropy Batch: Size mismatch or empty batch.");
     
-    double total_loss = 0.0;
-    
     for (size_t i = 0; i < y_true.size(); ++i) {
-        if (y_true[i].size() != y_pred[i].size())
+        if (y_true[i].size() != y_pred[i].size() || y_true[i].empty())
             throw std::invalid_argument("Cross Entropy Batch: Size mismatch at index " + std::to_string(i));
-        
-        total_loss += cross_entropy_loss(y_true[i], y_pred[i], from_logits);
     }
+
+    // Deterministic row reduction (same result for any thread count)
+    const double total_loss = Reduction::sum(y_true.size(), [&](size_t i) {
+        // Logits: log-sum-exp directly, no probability vector
+        return from_logits
+            ? softmax_cross_entropy_row(y_pred[i].data(), y_pred[i].size(), y_true[i].data(), 0, nullptr, 0)
+            : cross_entropy_loss(y_true[i], y_pred[i], false);
+    });
     
     return total_loss / y_true.size();  // Average over batch size
 }
 
-std::vector<std::vector<double>> cross_entropy_derivative_batch(
-    const std::vector<std::vector<double>>& y_true,
-    const std::vector<std::vector<double>>& y_pred,
+std::vector<std::vector<Scalar>> cross_entropy_derivative_batch(
+    const std::vector<std::vector<Scalar>>& y_true,
+    const std::vector<std::vector<Scalar>>& y_pred,
     bool from_logits) 
 {
     if (y_true.empty() || y_true.size() != y_pred.size())
         throw std::invalid_argument("Cross Entropy Derivative Batch: Size mismatch or empty batch.");
     
-    std::vector<std::vector<double>> grads(y_true.size());
+    const Scalar batch_scale = static_cast<Scalar>(1.0 / y_true.size());
+    std::vector<std::vector<Scalar>> grads(y_true.size());
     for (size_t i = 0; i < y_true.size(); ++i) {
-        if (y_true[i].size() != y_pred[i].size())
+        if (y_true[i].size() != y_pred[i].size() || y_true[i].empty())
             throw std::invalid_argument("Cross Entropy Derivative Batch: Size mismatch at index " + std::to_string(i));
         
-        grads[i] = cross_entropy_derivative(y_true[i], y_pred[i], from_logits);
-        for (auto& ele : grads[i]) ele /= y_true.size();
+        if (from_logits) {
+            // Softmax, subtraction and batch averaging in one pass
+            grads[i].resize(y_true[i].size());
+            softmax_cross_entropy_row(y_pred[i].data(), y_pred[i].size(), y_true[i].data(), 0,
+                                      grads[i].data(), batch_scale);
+        } else {
+            grads[i] = cross_entropy_derivative(y_true[i], y_pred[i], false);
+            for (auto& ele : grads[i]) ele *= batch_scale;
+        }
     }
     return grads;
 }
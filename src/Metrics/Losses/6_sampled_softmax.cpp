@@ -0,0 +1,116 @@
+#include "Metrics/SampledSoftmax.h"
+#include "Utils/FastMath.h"
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Losses {
+
+CandidateSampler::CandidateSampler(size_t num_classes, unsigned int seed)
+    : distribution(Distribution::LOG_UNIFORM), num_classes(num_classes), rng(seed)
+{
+    if (num_classes == 0) {
+        throw std::invalid_argument("CandidateSampler: num_classes must be > 0");
+    }
+    log_range = std::log(static_cast<double>(num_classes) + 1.0);
+}
+
+CandidateSampler::CandidateSampler(const std::vector<double>& counts, double power, unsigned int seed)
+    : distribution(Distribution::UNIGRAM), num_classes(counts.size()), rng(seed)
+{
+    if (counts.empty()) {
+        throw std::invalid_argument("CandidateSampler: counts must not be empty");
+    }
+    cdf.resize(counts.size());
+    double total = 0.0;
+    for (size_t c = 0; c < counts.size(); ++c) {
+        // A zero-count class would have Q(c) = 0 and an infinite logit correction
+        if (!(counts[c] > 0.0)) {
+            throw std::invalid_argument("CandidateSampler: counts must be positive (class " +
+                                        std::to_string(c) + ")");
+        }
+        total += std::pow(counts[c], power);
+        cdf[c] = total;
+    }
+    if (!(total > 0.0) || !std::isfinite(total)) {
+        throw std::invalid_argument("CandidateSampler: counts^power must sum to a positive, finite value");
+    }
+}
+
+void CandidateSampler::sample(size_t num_sampled, std::vector<size_t>& out) {
+    out.resize(num_sampled);
+    if (distribution == Distribution::LOG_UNIFORM) {
+        // Inverse CDF: c = floor(exp(u * log(V + 1))) - 1
+        for (size_t k = 0; k < num_sampled; ++k) {
+            const double value = std::exp(uniform(rng) * log_range) - 1.0;
+            out[k] = std::min(static_cast<size_t>(value), num_classes - 1);
+        }
+    } else {
+        const double total = cdf.back();
+        for (size_t k = 0; k < num_sampled; ++k) {
+            const double target = uniform(rng) * total;
+            const size_t c = std::upper_bound(cdf.begin(), cdf.end(), target) - cdf.begin();
+            out[k] = std::min(c, num_classes - 1);
+        }
+    }
+}
+
+double CandidateSampler::probability(size_t c) const {
+    if (c >= num_classes) {
+        throw std::out_of_range("CandidateSampler::probability: class id out of range");
+    }
+    if (distribution == Distribution::LOG_UNIFORM) {
+        return std::log((c + 2.0) / (c + 1.0)) / log_range;
+    }
+    const double mass = cdf[c] - (c == 0 ? 0.0 : cdf[c - 1]);
+    return mass / cdf.back();
+}
+
+double CandidateSampler::logExpectedCount(size_t c, size_t num_sampled) const {
+    return std::log(static_cast<double>(num_sampled) * probability(c));
+}
+
+double sampled_softmax_loss(const Scalar* logits, const size_t* candidates, size_t num_candidates,
+                            const CandidateSampler& sampler, Scalar* grad, bool remove_accidental_hits) {
+    std::vector<double> corrected;
+    return sampled_softmax_loss(logits, candidates, num_candidates, sampler, grad, corrected,
+                                remove_accidental_hits);
+}
+
+double sampled_softmax_loss(const Scalar* logits, const size_t* candidates, size_t num_candidates,
+                            const CandidateSampler& sampler, Scalar* grad, std::vector<double>& corrected,
+                            bool remove_accidental_hits) {
+    if (num_candidates < 2) {
+        throw std::invalid_argument("sampled_softmax_loss: Need the true class and at least one sample");
+    }
+    const size_t num_sampled = num_candidates - 1;
+    const size_t label = candidates[0];
+    const double neg_inf = -std::numeric_limits<double>::infinity();
+
+    // Corrected logits, once: z'_k = z_k - log(num_sampled * Q(c_k)); accidental hits masked out
+    corrected.resize(num_candidates);
+    double max_logit = neg_inf;
+    for (size_t k = 0; k < num_candidates; ++k) {
+        corrected[k] = (k > 0 && remove_accidental_hits && candidates[k] == label)
+            ? neg_inf
+            : static_cast<double>(logits[k]) - sampler.logExpectedCount(candidates[k], num_sampled);
+        max_logit = std::max(max_logit, corrected[k]);
+    }
+
+    double sum = 0.0;
+    for (size_t k = 0; k < num_candidates; ++k) sum += FastMath::exp(corrected[k] - max_logit);
+    const double log_sum = std::log(sum) + max_logit;
+
+    if (grad) {
+        // logits are no longer read, so grad may alias them
+        for (size_t k = 0; k < num_candidates; ++k) {
+            const double p = FastMath::exp(corrected[k] - log_sum);
+            grad[k] = static_cast<Scalar>(p - (k == 0 ? 1.0 : 0.0));
+        }
+    }
+    return log_sum - corrected[0];
+}
+
+} // namespace Losses
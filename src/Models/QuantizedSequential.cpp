@@ -0,0 +1,258 @@
+#include "Models/QuantizedSequential.h"
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+inline int8_t quantizeValue(double value, double inv_scale) {
+    const long q = std::lround(value * inv_scale);
+    return static_cast<int8_t>(std::clamp<long>(q, -127, 127));
+}
+
+// Rounded in double and clamped before the cast: tiny scales would overflow int32
+inline int32_t quantizeBias(double value, double inv_scale) {
+    const double q = std::round(value * inv_scale);
+    return static_cast<int32_t>(std::clamp<double>(q, std::numeric_limits<int32_t>::min(),
+                                                    std::numeric_limits<int32_t>::max()));
+}
+
+inline float scaleFromRange(double max_abs) {
+    return max_abs > 0.0 ? static_cast<float>(max_abs / 127.0) : 1.0f;
+}
+
+} // namespace
+
+QuantizedSequential::QuantizedDense QuantizedSequential::quantizeDense(const DenseLayer& layer, float input_scale) {
+    if (!layer.isInitialized()) {
+        throw std::invalid_argument("QuantizedSequential: Dense layer parameters not initialized");
+    }
+    const ConstMatrixView weights = layer.getWeights();
+    const Scalar* biases = layer.getBiases();
+
+    QuantizedDense q;
+    q.output_size = weights.rows;
+    q.input_size = weights.cols;
+    q.input_scale = input_scale;
+    q.weights.resize(q.output_size * q.input_size);
+    q.weight_scales.resize(q.output_size);
+    q.biases.resize(q.output_size);
+    q.output_multipliers.resize(q.output_size);
+
+    for (size_t i = 0; i < q.output_size; ++i) {
+        double max_abs = 0.0;
+        const Scalar* row = weights.row(i);
+        for (size_t j = 0; j < q.input_size; ++j) max_abs = std::max(max_abs, std::abs(static_cast<double>(row[j])));
+        const float w_scale = scaleFromRange(max_abs);
+        const double inv_w_scale = 1.0 / w_scale;
+
+        for (size_t j = 0; j < q.input_size; ++j) {
+            q.weights[i * q.input_size + j] = quantizeValue(row[j], inv_w_scale);
+        }
+        q.weight_scales[i] = w_scale;
+        q.output_multipliers[i] = input_scale * w_scale;
+        q.biases[i] = quantizeBias(biases[i], 1.0 / (static_cast<double>(input_scale) * w_scale));
+    }
+    return q;
+}
+
+QuantizedSequential::QuantizedSequential(Sequential& model, const Dataset& calibration, size_t max_samples) {
+    if (calibration.rows() == 0) {
+        throw std::invalid_argument("QuantizedSequential: Calibration dataset is empty");
+    }
+
+    // Build the stage layout, fusing ReLU / Leaky ReLU / Linear into the preceding Dense layer
+    std::vector<size_t> dense_layer_index;  // model layer index of each dense stage
+    for (size_t i = 0; i < model.size(); ++i) {
+        auto* dense_layer = dynamic_cast<DenseLayer*>(model[i]);
+        auto* act_layer = dynamic_cast<ActivationLayer*>(model[i]);
+        Stage stage;
+
+        if (dense_layer) {
+            stage.is_dense = true;
+            dense_layer_index.push_back(i);
+            auto* fused_layer = dynamic_cast<DenseActivationLayer*>(dense_layer);
+            if (fused_layer) {
+                ActivationType type = fused_layer->getActivationType();
+                if (type == ActivationType::RELU || type == ActivationType::LEAKY_RELU ||
+                    type == ActivationType::LINEAR) {
+                    stage.dense.fused_activation = type;
+                    stage.dense.alpha = fused_layer->getAlpha();
+                    stages.push_back(stage);
+                } else {
+                    // Activation without an integer epilogue: run it in float after the layer
+                    stages.push_back(stage);
+                    Stage act_stage;
+                    act_stage.is_dense = false;
+                    act_stage.activation = type;
+                    act_stage.alpha = fused_layer->getAlpha();
+                    act_stage.lambda = fused_layer->getLambda();
+                    stages.push_back(act_stage);
+                }
+                continue;
+            }
+            if (i + 1 < model.size()) {
+                auto* next_act = dynamic_cast<ActivationLayer*>(model[i + 1]);
+                if (next_act) {
+                    ActivationType type = next_act->getActivationType();
+                    if (type == ActivationType::RELU || type == ActivationType::LEAKY_RELU ||
+                        type == ActivationType::LINEAR) {
+                        stage.dense.fused_activation = type;
+                        stage.dense.alpha = next_act->getAlpha();
+                        ++i;  // activation consumed by fusion
+                    }
+                }
+            }
+        } else if (act_layer) {
+            stage.is_dense = false;
+            stage.activation = act_layer->getActivationType();
+            stage.alpha = act_layer->getAlpha();
+            stage.lambda = act_layer->getLambda();
+        } else {
+            throw std::invalid_argument("QuantizedSequential: Unsupported layer type at index " + std::to_string(i));
+        }
+        stages.push_back(stage);
+    }
+    if (dense_layer_index.empty()) {
+        throw std::invalid_argument("QuantizedSequential: Model has no Dense layers");
+    }
+
+    // Calibrate: record max |input| of every Dense layer using the float model's
+    // cache-free predict path, so the model's training caches are left untouched
+    std::vector<double> input_range(model.size(), 0.0);
+    const size_t n_samples = std::min(max_samples == 0 ? calibration.rows() : max_samples, calibration.rows());
+    std::vector<Scalar> x, y;
+    for (size_t s = 0; s < n_samples; ++s) {
+        x = calibration[s];
+        for (size_t i = 0; i < model.size(); ++i) {
+            if (dynamic_cast<DenseLayer*>(model[i])) {
+                for (Scalar v : x) input_range[i] = std::max(input_range[i], std::abs(static_cast<double>(v)));
+            }
+            y.resize(model[i]->outputSize(x.size()));
+            model[i]->predictInto(x.data(), x.size(), y.data());
+            x.swap(y);
+        }
+    }
+
+    // Quantize parameters with the calibrated input scales
+    size_t dense_count = 0;
+    for (auto& stage : stages) {
+        if (!stage.is_dense) continue;
+        const size_t layer_idx = dense_layer_index[dense_count++];
+        auto* dense_layer = static_cast<DenseLayer*>(model[layer_idx]);
+        ActivationType fused = stage.dense.fused_activation;
+        double alpha = stage.dense.alpha;
+        stage.dense = quantizeDense(*dense_layer, scaleFromRange(input_range[layer_idx]));
+        stage.dense.fused_activation = fused;
+        stage.dense.alpha = alpha;
+    }
+    input_size = stages.front().is_dense ? stages.front().dense.input_size : calibration.cols();
+
+    // A Dense stage feeding another Dense stage directly stays in int8
+    for (size_t s = 0; s + 1 < stages.size(); ++s) {
+        if (stages[s].is_dense && stages[s + 1].is_dense) {
+            stages[s].dense.int8_output = true;
+            stages[s].dense.output_scale = stages[s + 1].dense.input_scale;
+        }
+    }
+}
+
+void QuantizedSequential::denseKernel(const QuantizedDense& layer, const int8_t* input,
+                                      std::vector<int8_t>& out_q, std::vector<Scalar>& out_f) {
+    const size_t in = layer.input_size;
+    const bool leaky = layer.fused_activation == ActivationType::LEAKY_RELU;
+    const bool relu = layer.fused_activation == ActivationType::RELU;
+    const float inv_out_scale = layer.int8_output ? 1.0f / layer.output_scale : 0.0f;
+
+    if (layer.int8_output) out_q.resize(layer.output_size);
+    else out_f.resize(layer.output_size);
+
+    for (size_t i = 0; i < layer.output_size; ++i) {
+        // int8 x int8 -> int32 accumulation
+        const int8_t* w = &layer.weights[i * in];
+        int32_t acc = layer.biases[i];
+        for (size_t j = 0; j < in; ++j) {
+            acc += static_cast<int32_t>(w[j]) * static_cast<int32_t>(input[j]);
+        }
+
+        // Fused activation applied on the accumulator, then rescale
+        float real = static_cast<float>(acc) * layer.output_multipliers[i];
+        if (acc < 0) {
+            if (relu) real = 0.0f;
+            else if (leaky) real *= static_cast<float>(layer.alpha);
+        }
+
+        if (layer.int8_output) {
+            const long q = std::lround(real * inv_out_scale);
+            out_q[i] = static_cast<int8_t>(std::clamp<long>(q, -127, 127));
+        } else {
+            out_f[i] = static_cast<Scalar>(real);
+        }
+    }
+}
+
+std::vector<Scalar> QuantizedSequential::forward(const std::vector<Scalar>& input) const {
+    if (input.size() != input_size) {
+        throw std::invalid_argument("QuantizedSequential::forward: Input size mismatch. Expected " +
+                                    std::to_string(input_size) + ", got " + std::to_string(input.size()));
+    }
+
+    std::vector<Scalar> values = input;     // float domain
+    std::vector<int8_t> q_values;           // int8 domain
+    bool in_int8 = false;
+
+    for (const auto& stage : stages) {
+        if (stage.is_dense) {
+            if (!in_int8) {
+                const double inv_scale = 1.0 / stage.dense.input_scale;
+                q_values.resize(values.size());
+                for (size_t j = 0; j < values.size(); ++j) {
+                    q_values[j] = quantizeValue(values[j], inv_scale);
+                }
+            }
+            std::vector<int8_t> next_q;
+            denseKernel(stage.dense, q_values.data(), next_q, values);
+            in_int8 = stage.dense.int8_output;
+            if (in_int8) q_values.swap(next_q);
+        } else {
+            values = applyActivation(values, stage.activation, stage.alpha, stage.lambda);
+        }
+    }
+    return values;
+}
+
+size_t QuantizedSequential::getParameterBytes() const {
+    size_t bytes = 0;
+    for (const auto& stage : stages) {
+        if (!stage.is_dense) continue;
+        const auto& d = stage.dense;
+        bytes += d.weights.size() * sizeof(int8_t)
+               + d.weight_scales.size() * sizeof(float)
+               + d.output_multipliers.size() * sizeof(float)
+               + d.biases.size() * sizeof(int32_t);
+    }
+    return bytes;
+}
+
+void QuantizedSequential::summary() const {
+    std::cout << "Quantized Sequential Model Summary (INT8):\n";
+    std::cout << "========================\n";
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const auto& stage = stages[i];
+        std::cout << "Stage " << i << ": ";
+        if (stage.is_dense) {
+            std::cout << "QDense: " << stage.dense.input_size << " -> " << stage.dense.output_size;
+            if (stage.dense.fused_activation != ActivationType::LINEAR) {
+                std::cout << " + " << activationTypeToString(stage.dense.fused_activation) << " (fused)";
+            }
+            std::cout << " | input scale: " << stage.dense.input_scale
+                      << " | output: " << (stage.dense.int8_output ? "int8" : "float") << "\n";
+        } else {
+            std::cout << "Float activation: " << activationTypeToString(stage.activation) << "\n";
+        }
+    }
+    std::cout << "Parameter bytes: " << getParameterBytes() << "\n";
+    std::cout << "========================\n";
+}
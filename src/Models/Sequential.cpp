@@ -1,51 +1,376 @@
 #include "Models/Sequential.h"
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 
 void Sequential::initializeParameters(unsigned int seed, double a, double b, double sparsity, double bias_value) {
     for (size_t i = 0; i < this->layers.size(); ++i) {
         auto* dense_layer = dynamic_cast<DenseLayer*>(this->layers[i].get());
         if (dense_layer) {
             InitMethod method = InitMethod::XAVIER_UNIFORM; // default
-            if (i + 1 < this->layers.size()) {
+
+            // Activation applied to this layer's output: fused or in the next layer
+            bool has_activation = false;
+            ActivationType act_type = ActivationType::LINEAR;
+            auto* fused_layer = dynamic_cast<DenseActivationLayer*>(dense_layer);
+            if (fused_layer) {
+                has_activation = true;
+                act_type = fused_layer->getActivationType();
+            } else if (i + 1 < this->layers.size()) {
                 auto* act_layer = dynamic_cast<ActivationLayer*>(this->layers[i + 1].get());
                 if (act_layer) {
-                    switch (act_layer->getActivationType()) {
-                        case ActivationType::RELU:
-                        case ActivationType::LEAKY_RELU:
-                            method = InitMethod::HE_UNIFORM;
-                            break;
-                        case ActivationType::SIGMOID:
-                        case ActivationType::TANH:
-                            method = InitMethod::XAVIER_UNIFORM;
-                            break;
-                        case ActivationType::SELU:
-                            method = InitMethod::LECUN_UNIFORM;
-                            break;
-                        default:
-                            method = InitMethod::XAVIER_UNIFORM;
-                            break;
-                    }
+                    has_activation = true;
+                    act_type = act_layer->getActivationType();
                 }
             }
+
+            if (has_activation) method = initMethodFor(act_type);
             dense_layer->initializeWeights(method, seed, a, b, sparsity, bias_value);
             dense_layer->initializeBiases(InitMethod::BIAS, seed, a, b, sparsity, bias_value);
         }
     }
 }
 
-std::vector<double> Sequential::forward(const std::vector<double>& input) const {
-    std::vector<double> output = input;
+InitMethod Sequential::initMethodFor(ActivationType act_type) {
+    switch (act_type) {
+        case ActivationType::RELU:
+        case ActivationType::LEAKY_RELU:
+            return InitMethod::HE_UNIFORM;
+        case ActivationType::SIGMOID:
+        case ActivationType::TANH:
+            return InitMethod::XAVIER_UNIFORM;
+        case ActivationType::SELU:
+            return InitMethod::LECUN_UNIFORM;
+        default:
+            return InitMethod::XAVIER_UNIFORM;
+    }
+}
+
+size_t Sequential::fuseLayers() {
+    size_t fused = 0;
+    std::vector<std::unique_ptr<BaseLayer>> new_layers;
+    new_layers.reserve(this->layers.size());
+
+    for (size_t i = 0; i < this->layers.size(); ++i) {
+        auto* dense_layer = dynamic_cast<DenseLayer*>(this->layers[i].get());
+        bool plain_dense = dense_layer && !dynamic_cast<DenseActivationLayer*>(dense_layer);
+        if (plain_dense && i + 1 < this->layers.size()) {
+            auto* act_layer = dynamic_cast<ActivationLayer*>(this->layers[i + 1].get());
+            if (act_layer && act_layer->getActivationType() != ActivationType::SOFTMAX) {
+                new_layers.push_back(std::make_unique<DenseActivationLayer>(
+                    *dense_layer, act_layer->getActivationType(),
+                    act_layer->getAlpha(), act_layer->getLambda()));
+                ++i;  // activation layer absorbed
+                ++fused;
+                continue;
+            }
+        }
+        new_layers.push_back(std::move(this->layers[i]));
+    }
+
+    this->layers = std::move(new_layers);
+    workers.clear();  // replicas no longer match the layer stack
+    checkpoints.clear();  // segment boundaries referred to the old indices
+    if (plan.compiled) compile(plan.widths[0]);
+    return fused;
+}
+
+void Sequential::compile(size_t input_size) {
+    if (this->layers.empty()) {
+        throw std::logic_error("Sequential::compile: Model has no layers");
+    }
+    ExecutionPlan new_plan;
+    new_plan.widths.push_back(input_size);
+    new_plan.slots.push_back(0);
     for (auto& layer : this->layers) {
-        output = layer->forward(output);
+        const size_t width = new_plan.widths.back();
+        const size_t slot = new_plan.slots.back();
+        new_plan.widths.push_back(layer->outputSize(width));
+        // Element-wise layers overwrite their input; others write to the free region
+        new_plan.slots.push_back(layer->isElementWise() ? slot : 1 - slot);
+    }
+    new_plan.region_size = *std::max_element(new_plan.widths.begin(), new_plan.widths.end());
+    new_plan.compiled = true;
+
+    plan = std::move(new_plan);
+    arena.assign(2 * plan.region_size, 0.0);
+}
+
+const Scalar* Sequential::runForward(const std::vector<std::unique_ptr<BaseLayer>>& stack, Scalar* arena_data,
+                                     const Scalar* input, size_t input_size) const {
+    if (input_size != plan.widths[0]) {
+        throw std::invalid_argument("Sequential::forward: Input size mismatch. Expected " +
+                                    std::to_string(plan.widths[0]) + ", got " + std::to_string(input_size));
+    }
+    const Scalar* src = input;
+    for (size_t i = 0; i < stack.size(); ++i) {
+        Scalar* dst = arena_data + plan.slots[i + 1] * plan.region_size;
+        stack[i]->forwardInto(src, plan.widths[i], dst);
+        src = dst;
+    }
+    return src;
+}
+
+const Scalar* Sequential::runBackward(const std::vector<std::unique_ptr<BaseLayer>>& stack, Scalar* arena_data) const {
+    for (size_t i = stack.size(); i-- > 0;) {
+        const Scalar* grad_output = arena_data + plan.slots[i + 1] * plan.region_size;
+        Scalar* grad_input = arena_data + plan.slots[i] * plan.region_size;
+        stack[i]->backwardInto(grad_output, plan.widths[i + 1], grad_input);
+    }
+    return arena_data + plan.slots[0] * plan.region_size;
+}
+
+void Sequential::forwardStack(const std::vector<std::unique_ptr<BaseLayer>>& stack, const std::vector<Scalar>& x,
+                              Worker& worker) const {
+    if (!checkpoints.empty()) {
+        forwardCheckpointed(stack, x, worker);
+        return;
+    }
+    if (!plan.compiled) {
+        worker.buffer.assign(x.begin(), x.end());
+        for (auto& layer : stack) layer->forwardInPlace(worker.buffer);
+        return;
+    }
+    if (worker.arena.size() != arena.size()) worker.arena.assign(arena.size(), 0.0);
+    const Scalar* output = runForward(stack, worker.arena.data(), x.data(), x.size());
+    worker.buffer.assign(output, output + plan.widths.back());
+}
+
+void Sequential::backwardStack(const std::vector<std::unique_ptr<BaseLayer>>& stack, std::vector<Scalar>& grad,
+                               Worker& worker) const {
+    if (!checkpoints.empty()) {
+        backwardCheckpointed(stack, grad, worker);
+        return;
+    }
+    if (!plan.compiled) {
+        for (auto layer = stack.rbegin(); layer != stack.rend(); ++layer) {
+            (*layer)->backwardInPlace(grad);
+        }
+        return;
+    }
+    if (grad.size() != plan.widths.back()) {
+        throw std::invalid_argument("Sequential::backward: Gradient size does not match the model output");
+    }
+    if (worker.arena.size() != arena.size()) worker.arena.assign(arena.size(), 0.0);
+    std::copy(grad.begin(), grad.end(), outputSlot(worker.arena.data()));
+    runBackward(stack, worker.arena.data());
+}
+
+void Sequential::forwardCheckpointed(const std::vector<std::unique_ptr<BaseLayer>>& stack,
+                                     const std::vector<Scalar>& x, Worker& worker) const {
+    const size_t segments = checkpoints.size();
+    worker.checkpoints.resize(segments - 1);
+    worker.buffer.assign(x.begin(), x.end());
+    for (size_t j = 0; j + 1 < segments; ++j) {
+        worker.checkpoints[j].assign(worker.buffer.begin(), worker.buffer.end());
+        // Cache-free, ping-ponging between buffer and scratch
+        for (size_t i = checkpoints[j]; i < checkpoints[j + 1]; ++i) {
+            const size_t n = worker.buffer.size();
+            worker.scratch.resize(stack[i]->outputSize(n));
+            stack[i]->predictInto(worker.buffer.data(), n, worker.scratch.data());
+            worker.buffer.swap(worker.scratch);
+        }
+    }
+    for (size_t i = checkpoints.back(); i < stack.size(); ++i) {
+        stack[i]->forwardInPlace(worker.buffer);
+    }
+}
+
+void Sequential::backwardCheckpointed(const std::vector<std::unique_ptr<BaseLayer>>& stack,
+                                      std::vector<Scalar>& grad, Worker& worker) const {
+    const size_t segments = checkpoints.size();
+    for (size_t j = segments; j-- > 0;) {
+        const size_t begin = checkpoints[j];
+        const bool recomputed = j + 1 < segments;
+        const size_t end = recomputed ? checkpoints[j + 1] : stack.size();
+        if (recomputed) {
+            // Recompute the segment from its stored input to rebuild the caches,
+            // in buffers recycled from the segment after it
+            worker.scratch.assign(worker.checkpoints[j].begin(), worker.checkpoints[j].end());
+            for (size_t i = begin; i < end; ++i) {
+                stack[i]->adoptCache(worker.cache_pool);
+                stack[i]->forwardInPlace(worker.scratch);
+            }
+        }
+        for (size_t i = end; i-- > begin;) {
+            stack[i]->backwardInPlace(grad);
+            // The last segment caches on every forward pass anyway: keep its buffers
+            if (recomputed) stack[i]->recycleCache(worker.cache_pool);
+        }
+    }
+}
+
+void Sequential::setCheckpoints(std::vector<size_t> boundaries) {
+    if (boundaries.empty()) {
+        checkpoints.clear();
+        return;
+    }
+    for (size_t index : boundaries) {
+        if (index >= this->layers.size()) {
+            throw std::out_of_range("Sequential::setCheckpoints: Layer index " + std::to_string(index) +
+                                    " out of range (model has " + std::to_string(this->layers.size()) + " layers)");
+        }
+    }
+    boundaries.push_back(0);
+    std::sort(boundaries.begin(), boundaries.end());
+    boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+    checkpoints = std::move(boundaries);
+}
+
+ConstMatrixView Sequential::forwardCompiled(const std::vector<Scalar>& input) const {
+    if (!plan.compiled) {
+        throw std::logic_error("Sequential::forwardCompiled: Call compile() first");
+    }
+    const Scalar* output = runForward(this->layers, arena.data(), input.data(), input.size());
+    return ConstMatrixView(output, 1, plan.widths.back());
+}
+
+std::vector<Scalar> Sequential::forward(const std::vector<Scalar>& input) const {
+    if (plan.compiled) {
+        ConstMatrixView output = forwardCompiled(input);
+        return std::vector<Scalar>(output.data, output.data + output.cols);
+    }
+    std::vector<Scalar> output = input;
+    for (auto& layer : this->layers) {
+        layer->forwardInPlace(output);
     }
     return output;
 }
 
-std::vector<double> Sequential::backward(const std::vector<double>& grad_output) {
-    std::vector<double> grad = grad_output;
+size_t Sequential::outputSize(size_t input_size) const {
+    size_t width = input_size;
+    for (const auto& layer : this->layers) width = layer->outputSize(width);
+    return width;
+}
+
+std::vector<Scalar> Sequential::predict(const std::vector<Scalar>& input) const {
+    std::vector<Scalar> output(outputSize(input.size()));
+    std::vector<Scalar> scratch;
+    predictInto(input.data(), input.size(), output.data(), scratch);
+    return output;
+}
+
+void Sequential::predictInto(const Scalar* input, size_t input_size, Scalar* output,
+                             std::vector<Scalar>& scratch) const {
+    if (this->layers.empty()) {
+        std::copy(input, input + input_size, output);
+        return;
+    }
+
+    // Hidden activations only; the last layer writes into output
+    size_t region_size = 0;
+    size_t width = input_size;
+    for (size_t i = 0; i + 1 < this->layers.size(); ++i) {
+        width = this->layers[i]->outputSize(width);
+        region_size = std::max(region_size, width);
+    }
+    if (scratch.size() < 2 * region_size) scratch.resize(2 * region_size);
+
+    const Scalar* src = input;
+    Scalar* current = nullptr;      // null while src is still the caller's input
+    size_t slot = 1;
+    width = input_size;
+    for (size_t i = 0; i < this->layers.size(); ++i) {
+        const BaseLayer& layer = *this->layers[i];
+        const size_t out_width = layer.outputSize(width);
+        Scalar* dst = output;
+        if (i + 1 < this->layers.size()) {
+            if (layer.isElementWise() && current) {
+                dst = current;
+            } else {
+                slot = 1 - slot;
+                dst = scratch.data() + slot * region_size;
+            }
+        }
+        layer.predictInto(src, width, dst);
+        src = current = dst;
+        width = out_width;
+    }
+}
+
+void Sequential::predictInto(const Dataset& X, MatrixView output) const {
+    const size_t rows = X.rows();
+    if (rows == 0) {
+        if (output.rows != 0) throw std::invalid_argument("Sequential::predict: Output must be empty for an empty dataset");
+        return;
+    }
+    const size_t input_size = X.cols();
+    const size_t cols = outputSize(input_size);
+    if (output.rows != rows || output.cols != cols) {
+        throw std::invalid_argument("Sequential::predict: Output must be [" + std::to_string(rows) +
+                                    " x " + std::to_string(cols) + "]");
+    }
+    if (this->layers.empty()) {
+        for (size_t r = 0; r < rows; ++r) std::copy(X[r].begin(), X[r].end(), output.row(r));
+        return;
+    }
+
+    // Widest matrix a block holds before the last layer (including the gathered input)
+    size_t max_width = input_size;
+    size_t width = input_size;
+    for (size_t i = 0; i + 1 < this->layers.size(); ++i) {
+        width = this->layers[i]->outputSize(width);
+        max_width = std::max(max_width, width);
+    }
+
+    // Blocks of rows go through the layers as matrices (two ping-pong regions per
+    // task); the last layer writes straight into its rows of output
+    const size_t block_rows = 32;
+    const size_t num_blocks = (rows + block_rows - 1) / block_rows;
+    const size_t region_size = block_rows * max_width;
+    ThreadPool::global().parallelFor(0, num_blocks, [&](size_t lo, size_t hi) {
+        std::vector<Scalar> scratch(2 * region_size);
+        for (size_t b = lo; b < hi; ++b) {
+            const size_t first = b * block_rows;
+            const size_t n = std::min(block_rows, rows - first);
+            for (size_t r = 0; r < n; ++r) {
+                std::copy(X[first + r].begin(), X[first + r].end(), scratch.data() + r * input_size);
+            }
+
+            ConstMatrixView src(scratch.data(), n, input_size);
+            size_t slot = 0;
+            for (size_t i = 0; i < this->layers.size(); ++i) {
+                const BaseLayer& layer = *this->layers[i];
+                const size_t out_width = layer.outputSize(src.cols);
+                MatrixView dst;
+                if (i + 1 == this->layers.size()) {
+                    dst = MatrixView(output.row(first), n, out_width, output.stride);
+                } else {
+                    if (!layer.isElementWise()) slot = 1 - slot;
+                    dst = MatrixView(scratch.data() + slot * region_size, n, out_width);
+                }
+                layer.predictBatch(src, dst);
+                src = dst;
+            }
+        }
+    });
+}
+
+Dataset Sequential::predict(const Dataset& X) const {
+    if (X.rows() == 0) return Dataset();
+    const size_t cols = outputSize(X.cols());
+    std::vector<Scalar> outputs(X.rows() * cols);
+    predictInto(X, MatrixView(outputs, X.rows(), cols));
+
+    std::vector<std::vector<Scalar>> rows(X.rows());
+    for (size_t r = 0; r < X.rows(); ++r) {
+        rows[r].assign(outputs.begin() + r * cols, outputs.begin() + (r + 1) * cols);
+    }
+    return Dataset(std::move(rows));
+}
+
+std::vector<Scalar> Sequential::backward(const std::vector<Scalar>& grad_output) {
+    if (plan.compiled) {
+        if (grad_output.size() != plan.widths.back()) {
+            throw std::invalid_argument("Sequential::backward: Gradient size does not match the model output");
+        }
+        std::copy(grad_output.begin(), grad_output.end(), outputSlot(arena.data()));
+        const Scalar* grad_input = runBackward(this->layers, arena.data());
+        return std::vector<Scalar>(grad_input, grad_input + plan.widths[0]);
+    }
+    std::vector<Scalar> grad = grad_output;
     for (auto it = this->layers.rbegin(); it != this->layers.rend(); ++it) {
-        grad = (*it)->backward(grad);
+        (*it)->backwardInPlace(grad);
     }
     return grad;
 }
@@ -64,10 +389,10 @@ void Sequential::summary() const {
 double Sequential::train(const Dataset& X_train,
                          const Dataset& y_train,
                          BaseOptim& optimizer,
-                         std::function<double(const std::vector<double>&, 
-                                              const std::vector<double>&)> loss_fn,
-                         std::function<std::vector<double>(const std::vector<double>&, 
-                                                           const std::vector<double>&)> grad_fn,
+                         std::function<double(const std::vector<Scalar>&, 
+                                              const std::vector<Scalar>&)> loss_fn,
+                         std::function<std::vector<Scalar>(const std::vector<Scalar>&, 
+                                                           const std::vector<Scalar>&)> grad_fn,
                          unsigned int seed
 ) {
     size_t batch_size = optimizer.getBatchSize();
@@ -76,49 +401,57 @@ double Sequential::train(const Dataset& X_train,
         optimizer.setBatchSize(batch_size);
     }
     DataLoader loader(X_train, batch_size, true, seed);
-    double total_loss = 0.0;
+    registerParameters();
+    Reduction::CompensatedSum total_loss;
     
     for (auto it = loader.begin(); it != loader.end(); ++it) {
-        Dataset batch = *it;
-        const auto& batch_data = batch.getData();
-        auto batch_indices = it.getIndices();
-        size_t current_batch_size = batch_data.size();
+        const std::vector<size_t> batch_indices = it.getIndices();
+        const size_t current_batch_size = batch_indices.size();
 
         // clear gradient cache 
-        this->clearGradients();
+        parameters.zeroGradients();
+        const size_t micro_size = microBatchSize(current_batch_size);
+        const size_t shards = prepareWorkers(micro_size);
         
-        // Process batch
-        for (size_t i = 0; i < current_batch_size; ++i) {
-            const auto& x = batch_data[i];
-            const auto& y_true = y_train[batch_indices[i]];
-            
-            // Forward pass
-            auto y_pred = forward(x);
-            
-            // Compute loss and gradient
-            total_loss += loss_fn(y_true, y_pred);
-            auto grad = grad_fn(y_true, y_pred);
-            
-            backward(grad);
+        // Process batch micro-batch by micro-batch (one shard per worker)
+        for (size_t begin = 0; begin < current_batch_size; begin += micro_size) {
+            const size_t* micro_indices = batch_indices.data() + begin;
+            total_loss += runShards(std::min(micro_size, current_batch_size - begin), shards,
+                [&](std::vector<std::unique_ptr<BaseLayer>>& stack, size_t k, Worker& worker) {
+                    const auto& x = X_train[micro_indices[k]];
+                    const auto& y_true = y_train[micro_indices[k]];
+
+                    // Forward pass
+                    forwardStack(stack, x, worker);
+                    const std::vector<Scalar>& y_pred = worker.buffer;
+
+                    // Compute loss and gradient
+                    const double sample_loss = loss_fn(y_true, y_pred);
+                    auto grad = grad_fn(y_true, y_pred);
+                    if (loss_scaling_enabled) {
+                        for (auto& g : grad) g *= loss_scale;
+                    }
+
+                    backwardStack(stack, grad, worker);
+                    return sample_loss;
+                });
         }
+        reduceWorkerGradients(shards);
         
-        // Update parameters
-        optimizer.step(getLayers(), current_batch_size);
-
-        // Notify optimizer after step (for schedulers)
-        optimizer.afterStep();
+        // Update parameters and notify optimizer (for schedulers)
+        optimizerStep(optimizer, current_batch_size, parameters);
     }
-    return total_loss / X_train.rows();
+    return total_loss.result() / X_train.rows();
 }
 
 double Sequential::train(
     const Dataset& X_train,
     const Dataset& y_train,
     BaseOptim& optimizer,
-    std::function<double(const std::vector<std::vector<double>>&, 
-                         const std::vector<std::vector<double>>&)> batch_loss_fn,
-    std::function<std::vector<std::vector<double>>(const std::vector<std::vector<double>>&, 
-                                                   const std::vector<std::vector<double>>&)> batch_grad_fn,
+    std::function<double(const std::vector<std::vector<Scalar>>&, 
+                         const std::vector<std::vector<Scalar>>&)> batch_loss_fn,
+    std::function<std::vector<std::vector<Scalar>>(const std::vector<std::vector<Scalar>>&, 
+                                                   const std::vector<std::vector<Scalar>>&)> batch_grad_fn,
     unsigned int seed
 ) {
     size_t batch_size = optimizer.getBatchSize();
@@ -127,56 +460,366 @@ double Sequential::train(
         optimizer.setBatchSize(batch_size);
     }
     DataLoader loader(X_train, batch_size, true, seed);
-    double total_loss = 0.0;
+    registerParameters();
+    Reduction::CompensatedSum total_loss;
+    std::vector<std::vector<Scalar>> batch_y;
+    std::vector<std::vector<Scalar>> batch_preds;
     
     for (auto it = loader.begin(); it != loader.end(); ++it) {
-        Dataset batch = *it;
-        const auto& batch_data = batch.getData();
-        auto batch_indices = it.getIndices();
-        size_t current_batch_size = batch_data.size();
+        const std::vector<size_t> batch_indices = it.getIndices();
+        const size_t current_batch_size = batch_indices.size();
         
-        // Prepare batch inputs and labels
-        std::vector<std::vector<double>> batch_y;
-        batch_y.reserve(current_batch_size);
-        for (auto idx : batch_indices) {
-            batch_y.push_back(y_train[idx]);
-        }
-
         // clearing gradient cache
-        this->clearGradients();
-        
-        // Forward pass for entire batch
-        std::vector<std::vector<double>> batch_preds;
-        batch_preds.reserve(current_batch_size);
-        for (const auto& x : batch_data) {
-            batch_preds.push_back(forward(x));
-        }
-        
-        // Compute batch loss
-        double batch_loss = batch_loss_fn(batch_y, batch_preds); 
-        total_loss += batch_loss * current_batch_size;
-        
-        // Compute batch gradients
-        auto batch_grads = batch_grad_fn(batch_y, batch_preds);
-        
-        // Backward pass for each sample in batch
-        for (const auto& grad : batch_grads) {
-            backward(grad);
+        parameters.zeroGradients();
+        const size_t micro_size = microBatchSize(current_batch_size);
+        const size_t shards = prepareWorkers(micro_size);
+
+        for (size_t begin = 0; begin < current_batch_size; begin += micro_size) {
+            const size_t count = std::min(micro_size, current_batch_size - begin);
+            const size_t* micro_indices = batch_indices.data() + begin;
+
+            // Prepare micro-batch labels
+            batch_y.resize(count);
+            for (size_t k = 0; k < count; ++k) {
+                batch_y[k] = y_train[micro_indices[k]];
+            }
+
+            // Forward pass for entire micro-batch
+            batch_preds.resize(count);
+            runShards(count, shards,
+                [&](std::vector<std::unique_ptr<BaseLayer>>& stack, size_t k, Worker& worker) {
+                    forwardStack(stack, X_train[micro_indices[k]], worker);
+                    batch_preds[k].assign(worker.buffer.begin(), worker.buffer.end());
+                    return 0.0;
+                });
+
+            // Compute micro-batch loss
+            double batch_loss = batch_loss_fn(batch_y, batch_preds);
+            total_loss += batch_loss * count;
+
+            // Compute micro-batch gradients, reweighted from the micro-batch
+            // mean to this micro-batch's share of the batch mean
+            auto batch_grads = batch_grad_fn(batch_y, batch_preds);
+            if (batch_grads.size() != count) {
+                throw std::invalid_argument("Sequential::train: batch_grad_fn must return one gradient per sample");
+            }
+            const Scalar grad_scale = static_cast<Scalar>(
+                (loss_scaling_enabled ? loss_scale : 1.0) * count / current_batch_size);
+            if (grad_scale != Scalar(1)) {
+                for (auto& grad : batch_grads)
+                    for (auto& g : grad) g *= grad_scale;
+            }
+
+            // Backward pass for each sample in micro-batch. Layers cache only the
+            // last forward pass, so each sample is re-run forward before its backward.
+            runShards(count, shards,
+                [&](std::vector<std::unique_ptr<BaseLayer>>& stack, size_t k, Worker& worker) {
+                    forwardStack(stack, X_train[micro_indices[k]], worker);
+                    backwardStack(stack, batch_grads[k], worker);
+                    return 0.0;
+                });
         }
+        reduceWorkerGradients(shards);
         
         // Update parameters
-        optimizer.step(getLayers(), current_batch_size);
-        optimizer.afterStep();
+        optimizerStep(optimizer, current_batch_size, parameters);
     } 
-    return total_loss / X_train.rows();
+    return total_loss.result() / X_train.rows();
+}
+
+double Sequential::trainSampled(
+    const Dataset& X_train,
+    const std::vector<size_t>& labels,
+    BaseOptim& optimizer,
+    Losses::CandidateSampler& sampler,
+    size_t num_sampled,
+    unsigned int seed
+) {
+    if (labels.size() != X_train.rows()) {
+        throw std::invalid_argument("Sequential::trainSampled: labels size does not match X_train rows");
+    }
+    if (num_sampled == 0) {
+        throw std::invalid_argument("Sequential::trainSampled: num_sampled must be > 0");
+    }
+    auto* output_layer = this->layers.empty() ? nullptr : dynamic_cast<DenseLayer*>(this->layers.back().get());
+    if (!output_layer || dynamic_cast<DenseActivationLayer*>(output_layer)) {
+        throw std::invalid_argument("Sequential::trainSampled: Last layer must be a plain DenseLayer");
+    }
+    if (output_layer->getOutputSize() != sampler.numClasses()) {
+        throw std::invalid_argument("Sequential::trainSampled: Sampler class count does not match output layer");
+    }
+
+    size_t batch_size = optimizer.getBatchSize();
+    if (batch_size == 0) {
+        batch_size = X_train.rows();
+        optimizer.setBatchSize(batch_size);
+    }
+    DataLoader loader(X_train, batch_size, true, seed);
+    registerParameters();
+    const auto& groups = parameters.getGroups();
+    if (groups.empty() || groups.back().layer != output_layer) {
+        throw std::runtime_error("Sequential::trainSampled: Output layer parameters not initialized");
+    }
+    const size_t hidden_layers = this->layers.size() - 1;
+    const size_t row_size = groups.back().weight_count / output_layer->getOutputSize();
+
+    ParameterRegistry step_parameters;
+    std::vector<size_t> rows;
+    std::vector<size_t> sampled;
+    std::vector<size_t> candidates(num_sampled + 1);
+    std::vector<Scalar> hidden, logits, grad;
+    std::vector<double> corrected;
+    Reduction::CompensatedSum total_loss;
+
+    for (auto it = loader.begin(); it != loader.end(); ++it) {
+        const std::vector<size_t> batch_indices = it.getIndices();
+        const size_t current_batch_size = batch_indices.size();
+        const Scalar grad_scale = static_cast<Scalar>(
+            (loss_scaling_enabled ? loss_scale : 1.0) / current_batch_size);
+
+        // Negatives are shared by the whole batch
+        sampler.sample(num_sampled, sampled);
+        std::copy(sampled.begin(), sampled.end(), candidates.begin() + 1);
+
+        // Output rows the batch reads; only these are zeroed and stepped
+        rows.assign(sampled.begin(), sampled.end());
+        for (size_t idx : batch_indices) {
+            if (labels[idx] >= sampler.numClasses()) {
+                throw std::out_of_range("Sequential::trainSampled: Label out of range");
+            }
+            rows.push_back(labels[idx]);
+        }
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        step_parameters.clear();
+        for (size_t g = 0; g + 1 < groups.size(); ++g) step_parameters.addGroup(groups[g]);
+        step_parameters.addRows(groups.back(), row_size, rows);
+        step_parameters.zeroGradients();
+
+        for (size_t idx : batch_indices) {
+            candidates[0] = labels[idx];
+
+            hidden.assign(X_train[idx].begin(), X_train[idx].end());
+            for (size_t l = 0; l < hidden_layers; ++l) this->layers[l]->forwardInPlace(hidden);
+            output_layer->forwardSampled(hidden, candidates, logits);
+
+            total_loss += Losses::sampled_softmax_loss(logits.data(), candidates.data(), candidates.size(),
+                                                       sampler, logits.data(), corrected);
+            for (auto& g : logits) g *= grad_scale;
+
+            output_layer->backwardSampled(logits, candidates, grad);
+            for (size_t l = hidden_layers; l-- > 0;) this->layers[l]->backwardInPlace(grad);
+        }
+
+        optimizerStep(optimizer, current_batch_size, step_parameters);
+    }
+    return total_loss.result() / X_train.rows();
 }
 
 
 void Sequential::clearGradients() {
-    std::vector<BaseLayer*> all_layers = this->getLayers();
-    for (auto& layer : all_layers) {
-        DenseLayer* dense_layer = dynamic_cast<DenseLayer*>(layer);
-        if (!dense_layer) return;
-        dense_layer->clearGradients();
+    registerParameters();
+    parameters.zeroGradients();
+}
+
+void Sequential::registerParameters() {
+    parameters.clear();
+    for (auto& layer : this->layers) parameters.add(*layer);
+    if (flat_parameters && !parameters.empty() && !parameters.isContiguous()) {
+        packParameters(this->layers, parameters, flat_values, flat_grads);
+    }
+}
+
+void Sequential::flattenParameters() {
+    flat_parameters = true;
+    registerParameters();
+}
+
+void Sequential::packParameters(const std::vector<std::unique_ptr<BaseLayer>>& stack,
+                                ParameterRegistry& registry,
+                                std::vector<Scalar>& values,
+                                std::vector<Scalar>& grads) {
+    registry.clear();
+    for (auto& layer : stack) registry.add(*layer);
+    if (registry.empty()) return;
+
+    // Layers copy from their current storage (possibly the old flat buffers) before those are released
+    std::vector<Scalar> new_values(registry.parameterCount());
+    std::vector<Scalar> new_grads(registry.parameterCount());
+    size_t offset = 0;
+    for (const ParameterGroup& group : registry.getGroups()) {
+        group.layer->bindParameters(new_values.data() + offset, new_grads.data() + offset);
+        offset += group.count;
     }
-}
\ No newline at end of file
+    values.swap(new_values);
+    grads.swap(new_grads);
+
+    registry.clear();
+    for (auto& layer : stack) registry.add(*layer);
+    if (!registry.isContiguous()) {
+        throw std::logic_error("Sequential::flattenParameters: A layer with parameters does not implement bindParameters");
+    }
+}
+
+void Sequential::setDataParallel(size_t num_replicas) {
+    data_parallel_replicas = num_replicas == 0 ? ThreadPool::global().size() : num_replicas;
+    if (workers.size() > data_parallel_replicas) workers.resize(data_parallel_replicas);
+}
+
+void Sequential::buildReplica(Worker& worker) {
+    // Replicas are cloned once; rebuilt only if the layer stack, its parameters or their layout changed
+    if (worker.layers.size() == this->layers.size() &&
+        worker.parameters.size() == parameters.size() &&
+        worker.parameters.parameterCount() == parameters.parameterCount() &&
+        worker.parameters.isContiguous() == parameters.isContiguous()) {
+        return;
+    }
+    worker.layers.clear();
+    worker.parameters.clear();
+    worker.velocity.clear();
+    for (auto& layer : this->layers) {
+        worker.layers.push_back(layer->clone());
+        worker.parameters.add(*worker.layers.back());
+    }
+    // Replicas follow the master layout, so copies and reductions are single passes
+    if (flat_parameters) {
+        packParameters(worker.layers, worker.parameters, worker.flat_values, worker.flat_grads);
+    }
+}
+
+size_t Sequential::prepareWorkers(size_t batch_size) {
+    const size_t shards = std::max<size_t>(1, std::min(data_parallel_replicas, batch_size));
+    if (workers.size() < shards) workers.resize(shards);
+
+    for (size_t s = 1; s < shards; ++s) buildReplica(workers[s]);
+
+    // Copy master values span by span and zero the replica gradients
+    const auto& master_groups = parameters.getGroups();
+    ThreadPool::global().parallelFor(1, shards, [&](size_t lo, size_t hi) {
+        for (size_t s = lo; s < hi; ++s) {
+            const ParameterRegistry& replica = workers[s].parameters;
+            const auto& replica_groups = replica.getGroups();
+            if (parameters.isContiguous() && replica.isContiguous()) {
+                std::copy(parameters.values(), parameters.values() + parameters.parameterCount(), replica.values());
+                std::fill(replica.gradients(), replica.gradients() + replica.parameterCount(), Scalar(0));
+            } else {
+                for (size_t g = 0; g < master_groups.size(); ++g) {
+                    for (size_t k = 0; k < master_groups[g].spans.size(); ++k) {
+                        const ParameterSpan& src = master_groups[g].spans[k];
+                        const ParameterSpan& dst = replica_groups[g].spans[k];
+                        std::copy(src.values, src.values + src.size, dst.values);
+                        std::fill(dst.grads, dst.grads + dst.size, Scalar(0));
+                    }
+                }
+            }
+            for (const ParameterGroup& group : replica_groups) group.layer->parametersChanged();
+        }
+    }, 1);
+    return shards;
+}
+
+void Sequential::refreshReplica(Worker& worker, bool changed_only) {
+    const auto& shared_groups = parameters.getGroups();
+    const auto& local_groups = worker.parameters.getGroups();
+    if (worker.seen_versions.size() != async_versions.size()) worker.seen_versions.assign(async_versions.size(), 0);
+
+    // Blocks are numbered as in SGD::stepAsync; the acquire load orders the copy after the writer's stores
+    size_t block = 0;
+    for (size_t g = 0; g < shared_groups.size(); ++g) {
+        bool refreshed = false;
+        for (size_t k = 0; k < shared_groups[g].spans.size(); ++k) {
+            const ParameterSpan& src = shared_groups[g].spans[k];
+            Scalar* dst = local_groups[g].spans[k].values;
+            for (size_t lo = 0; lo < src.size; lo += SGD::kAsyncBlock, ++block) {
+                const uint32_t version = Atomics::loadAcquire(&async_versions[block]);
+                if (changed_only && version == worker.seen_versions[block]) continue;
+                worker.seen_versions[block] = version;
+                Atomics::copyRelaxed(dst + lo, src.values + lo, std::min(SGD::kAsyncBlock, src.size - lo));
+                refreshed = true;
+            }
+        }
+        if (refreshed) local_groups[g].layer->parametersChanged();
+    }
+}
+
+void Sequential::reduceWorkerGradients(size_t shards) {
+    if (shards <= 1) return;
+    // Every element sums the replicas in shard order
+    bool flat = parameters.isContiguous();
+    for (size_t s = 1; s < shards; ++s) flat = flat && workers[s].parameters.isContiguous();
+    if (flat) {
+        Scalar* grads = parameters.gradients();
+        ThreadPool::global().parallelFor(0, parameters.parameterCount(), [&](size_t lo, size_t hi) {
+            for (size_t s = 1; s < shards; ++s) {
+                const Scalar* replica = workers[s].parameters.gradients();
+                for (size_t j = lo; j < hi; ++j) grads[j] += replica[j];
+            }
+        }, ParameterRegistry::kChunkSize);
+        return;
+    }
+
+    // Otherwise span by span, spans in parallel
+    for (size_t g = 0; g < parameters.size(); ++g) {
+        const ParameterGroup& master = parameters.getGroups()[g];
+        ThreadPool::global().parallelFor(0, master.spans.size(), [&](size_t lo, size_t hi) {
+            for (size_t k = lo; k < hi; ++k) {
+                Scalar* grads = master.spans[k].grads;
+                for (size_t s = 1; s < shards; ++s) {
+                    const Scalar* replica = workers[s].parameters.getGroups()[g].spans[k].grads;
+                    for (size_t j = 0; j < master.spans[k].size; ++j) grads[j] += replica[j];
+                }
+            }
+        }, master.grain);
+    }
+}
+
+void Sequential::optimizerStep(BaseOptim& optimizer, size_t batch_size, const ParameterRegistry& step_parameters) {
+    if (loss_scaling_enabled) {
+        if (!step_parameters.gradientsFinite()) {
+            // Overflow: drop this step and retry with a smaller scale
+            step_parameters.zeroGradients();
+            if (dynamic_loss_scaling) {
+                loss_scale = std::max(1.0, loss_scale * 0.5);
+                loss_scale_good_steps = 0;
+            }
+            return;
+        }
+
+        step_parameters.scaleGradients(1.0 / loss_scale);
+
+        if (dynamic_loss_scaling && ++loss_scale_good_steps >= loss_scale_growth_interval) {
+            loss_scale *= 2.0;
+            loss_scale_good_steps = 0;
+        }
+    }
+
+    optimizer.step(step_parameters, batch_size);
+    optimizer.afterStep();
+}
+
+void Sequential::setStoragePrecision(StoragePrecision precision) {
+    for (auto& layer : this->layers) {
+        auto* dense_layer = dynamic_cast<DenseLayer*>(layer.get());
+        if (dense_layer) dense_layer->setStoragePrecision(precision);
+    }
+    // Replicas were cloned with the old storage precision
+    workers.clear();
+}
+
+void Sequential::enableLossScaling(double initial_scale, bool dynamic, size_t growth_interval) {
+    if (initial_scale <= 0.0 || growth_interval == 0) {
+        throw std::invalid_argument("Sequential::enableLossScaling: scale and growth interval must be positive");
+    }
+    loss_scaling_enabled = true;
+    dynamic_loss_scaling = dynamic;
+    loss_scale = initial_scale;
+    loss_scale_growth_interval = growth_interval;
+    loss_scale_good_steps = 0;
+}
+
+void Sequential::disableLossScaling() {
+    loss_scaling_enabled = false;
+    loss_scale = 1.0;
+    loss_scale_good_steps = 0;
+}
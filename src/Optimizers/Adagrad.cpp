@@ -0,0 +1,27 @@
+#include "Optimizers/Adagrad.h"
+#include "Optimizers/UpdateKernels.h"
+#include <stdexcept>
+#include <algorithm>
+
+Adagrad::Adagrad(double lr, double epsilon, double weight_decay, double initial_accumulator,
+                 size_t batch_size, std::function<double(double, size_t)> scheduler)
+    : AdaptiveOptim(lr, batch_size, scheduler),
+      epsilon(epsilon), weight_decay(weight_decay), initial_accumulator(initial_accumulator) {
+    if (epsilon <= 0.0) {
+        throw std::invalid_argument("Adagrad: epsilon must be positive");
+    }
+    if (initial_accumulator < 0.0) {
+        throw std::invalid_argument("Adagrad: initial_accumulator must be non-negative");
+    }
+}
+
+void Adagrad::initState(Scalar* layer_state, size_t count) {
+    std::fill(layer_state, layer_state + count, static_cast<Scalar>(initial_accumulator));
+}
+
+void Adagrad::updateLayer(const ParameterGroup& group, Scalar* layer_state) {
+    ParameterRegistry::update(group, [&](Scalar* params, Scalar* grads, size_t n, size_t offset) {
+        UpdateKernels::adagrad(params, grads, layer_state + offset, n,
+                               learning_rate, epsilon, weight_decay, clip_value_, grad_scale_);
+    });
+}
@@ -0,0 +1,38 @@
+#include "Optimizers/Adam.h"
+#include "Optimizers/UpdateKernels.h"
+#include <stdexcept>
+#include <cmath>
+
+Adam::Adam(double lr, double beta1, double beta2, double epsilon, double weight_decay,
+           size_t batch_size, std::function<double(double, size_t)> scheduler)
+    : AdaptiveOptim(lr, batch_size, scheduler),
+      beta1(beta1), beta2(beta2), epsilon(epsilon), weight_decay(weight_decay) {
+    if (beta1 < 0.0 || beta1 >= 1.0 || beta2 < 0.0 || beta2 >= 1.0) {
+        throw std::invalid_argument("Adam: betas must be in [0, 1)");
+    }
+    if (epsilon <= 0.0) {
+        throw std::invalid_argument("Adam: epsilon must be positive");
+    }
+}
+
+void Adam::updateLayer(const ParameterGroup& group, Scalar* layer_state) {
+    const double t = static_cast<double>(update_count);
+    const double bias_correction1 = 1.0 - std::pow(beta1, t);
+    const double bias_correction2 = 1.0 - std::pow(beta2, t);
+    Scalar* m = layer_state;
+    Scalar* v = layer_state + group.count;
+
+    // Clip, moments, bias-corrected update and gradient zeroing in one pass
+    ParameterRegistry::update(group, [&](Scalar* params, Scalar* grads, size_t n, size_t offset) {
+        UpdateKernels::adam(params, grads, m + offset, v + offset, n,
+                            learning_rate, beta1, beta2, epsilon,
+                            bias_correction1, bias_correction2,
+                            weight_decay, decoupled_decay, clip_value_, grad_scale_);
+    });
+}
+
+AdamW::AdamW(double lr, double weight_decay, double beta1, double beta2, double epsilon,
+             size_t batch_size, std::function<double(double, size_t)> scheduler)
+    : Adam(lr, beta1, beta2, epsilon, weight_decay, batch_size, scheduler) {
+    decoupled_decay = true;
+}
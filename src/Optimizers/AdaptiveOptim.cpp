@@ -0,0 +1,60 @@
+#include "Optimizers/AdaptiveOptim.h"
+#include "Optimizers/GradientClipping.h"
+#include <stdexcept>
+
+AdaptiveOptim::AdaptiveOptim(double lr, size_t batch_size,
+                             std::function<double(double, size_t)> scheduler)
+    : learning_rate(lr), initial_lr(lr), batch_size(batch_size), lr_scheduler(scheduler) {
+    if (lr <= 0.0) {
+        throw std::invalid_argument("AdaptiveOptim: Learning rate must be positive");
+    }
+}
+
+void AdaptiveOptim::step(const ParameterRegistry& parameters, size_t batch_size) {
+    if (batch_size == 0) {
+        throw std::invalid_argument("Batch size must be positive");
+    }
+    ++update_count;
+
+    // Global-norm clipping: one reduction, factor folded into the update kernel
+    grad_scale_ = 1.0;
+    if (clip_norm_ > 0.0) {
+        last_grad_norm_ = GradientClipping::globalNorm(parameters);
+        grad_scale_ = GradientClipping::scaleFactor(last_grad_norm_, clip_norm_);
+    }
+    for (const ParameterGroup& group : parameters.getGroups()) {
+        // State is looked up once per layer, not per element
+        auto& buffer = state[group.layer];
+        if (buffer.size() != stateSlots() * group.count) {
+            buffer.assign(stateSlots() * group.count, 0.0);
+            initState(buffer.data(), group.count);
+        }
+        updateLayer(group, buffer.data());
+    }
+}
+
+void AdaptiveOptim::afterStep() {
+    step_count++;
+    if (lr_scheduler) {
+        learning_rate = lr_scheduler(initial_lr, step_count);
+    }
+}
+
+void AdaptiveOptim::setLRScheduler(std::function<double(double, size_t)> scheduler) {
+    lr_scheduler = scheduler;
+}
+
+void AdaptiveOptim::setLearningRate(double lr) {
+    learning_rate = lr;
+    if (!lr_scheduler) initial_lr = lr;
+}
+
+void AdaptiveOptim::decayLearningRate(double decay_factor) {
+    learning_rate *= decay_factor;
+    if (!lr_scheduler) initial_lr = learning_rate;
+}
+
+void AdaptiveOptim::resetState() {
+    state.clear();
+    update_count = 0;
+}
@@ -0,0 +1,15 @@
+#include "Optimizers/GradientClipping.h"
+#include <cmath>
+
+namespace GradientClipping {
+
+double globalNorm(const ParameterRegistry& parameters) {
+    return std::sqrt(parameters.gradientSquaredNorm());
+}
+
+double scaleFactor(double norm, double max_norm) {
+    if (max_norm <= 0.0 || !(norm > max_norm)) return 1.0;
+    return max_norm / norm;
+}
+
+} // namespace GradientClipping
@@ -0,0 +1,51 @@
+#include "Optimizers/LAMB.h"
+#include "Optimizers/UpdateKernels.h"
+#include <stdexcept>
+#include <cmath>
+
+LAMB::LAMB(double lr, double beta1, double beta2, double epsilon, double weight_decay,
+           size_t batch_size, std::function<double(double, size_t)> scheduler)
+    : AdaptiveOptim(lr, batch_size, scheduler),
+      beta1(beta1), beta2(beta2), epsilon(epsilon), weight_decay(weight_decay) {
+    if (beta1 < 0.0 || beta1 >= 1.0 || beta2 < 0.0 || beta2 >= 1.0) {
+        throw std::invalid_argument("LAMB: betas must be in [0, 1)");
+    }
+    if (epsilon <= 0.0) {
+        throw std::invalid_argument("LAMB: epsilon must be positive");
+    }
+}
+
+void LAMB::updateLayer(const ParameterGroup& group, Scalar* layer_state) {
+    const double t = static_cast<double>(update_count);
+    const double bias_correction1 = 1.0 - std::pow(beta1, t);
+    const double bias_correction2 = 1.0 - std::pow(beta2, t);
+    const size_t bias_offset = group.weight_count;
+    Scalar* m = layer_state;
+    Scalar* v = layer_state + group.count;
+
+    // ||w||^2 of the weight matrix, then pass 1: moments, gradient zeroing and ||u||^2
+    const double weight_sq = ParameterRegistry::reduce(group, [](Scalar* params, Scalar*, size_t n, size_t) {
+        double sq = 0.0;
+        for (size_t i = 0; i < n; ++i) sq += static_cast<double>(params[i]) * params[i];
+        return sq;
+    }).first;
+    const double update_sq = ParameterRegistry::reduce(group, [&](Scalar* params, Scalar* grads, size_t n, size_t offset) {
+        const bool is_bias = offset >= bias_offset;
+        return UpdateKernels::lambMoments(params, grads, m + offset, v + offset, n,
+                                          beta1, beta2, epsilon, bias_correction1, bias_correction2,
+                                          is_bias ? 0.0 : weight_decay, clip_value_, grad_scale_);
+    }).first;
+
+    const double weight_norm = std::sqrt(weight_sq);
+    const double update_norm = std::sqrt(update_sq);
+    const double trust = (weight_norm > 0.0 && update_norm > 0.0) ? weight_norm / update_norm : 1.0;
+
+    // Pass 2: apply the trust-scaled step (biases: plain Adam step)
+    ParameterRegistry::update(group, [&](Scalar* params, Scalar*, size_t n, size_t offset) {
+        const bool is_bias = offset >= bias_offset;
+        UpdateKernels::lambApply(params, m + offset, v + offset, n,
+                                 learning_rate * (is_bias ? 1.0 : trust), epsilon,
+                                 bias_correction1, bias_correction2,
+                                 is_bias ? 0.0 : weight_decay);
+    });
+}
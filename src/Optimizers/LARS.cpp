@@ -0,0 +1,47 @@
+#include "Optimizers/LARS.h"
+#include "Optimizers/UpdateKernels.h"
+#include <stdexcept>
+#include <cmath>
+
+LARS::LARS(double lr, double momentum, double weight_decay, double trust_coefficient,
+           double epsilon, size_t batch_size, std::function<double(double, size_t)> scheduler)
+    : AdaptiveOptim(lr, batch_size, scheduler),
+      momentum(momentum), weight_decay(weight_decay),
+      trust_coefficient(trust_coefficient), epsilon(epsilon) {
+    if (trust_coefficient <= 0.0) {
+        throw std::invalid_argument("LARS: trust_coefficient must be positive");
+    }
+    if (epsilon < 0.0) {
+        throw std::invalid_argument("LARS: epsilon must be non-negative");
+    }
+}
+
+void LARS::updateLayer(const ParameterGroup& group, Scalar* layer_state) {
+    // ||w|| and ||g|| of the weight matrix (parallel over rows)
+    const double weight_norm = std::sqrt(ParameterRegistry::reduce(group,
+        [](Scalar* params, Scalar*, size_t n, size_t) {
+            double sq = 0.0;
+            for (size_t i = 0; i < n; ++i) sq += static_cast<double>(params[i]) * params[i];
+            return sq;
+        }).first);
+    const double grad_norm = grad_scale_ * std::sqrt(ParameterRegistry::reduce(group,
+        [](Scalar*, Scalar* grads, size_t n, size_t) {
+            double sq = 0.0;
+            for (size_t i = 0; i < n; ++i) sq += static_cast<double>(grads[i]) * grads[i];
+            return sq;
+        }).first);
+
+    double trust = 1.0;
+    if (weight_norm > 0.0 && grad_norm > 0.0) {
+        trust = trust_coefficient * weight_norm / (grad_norm + weight_decay * weight_norm + epsilon);
+    }
+
+    const size_t bias_offset = group.weight_count;
+    const double weight_lr = learning_rate * trust;
+    ParameterRegistry::update(group, [&](Scalar* params, Scalar* grads, size_t n, size_t offset) {
+        const bool is_bias = offset >= bias_offset;
+        UpdateKernels::lars(params, grads, layer_state + offset, n,
+                            is_bias ? learning_rate : weight_lr, momentum,
+                            is_bias ? 0.0 : weight_decay, clip_value_, grad_scale_);
+    });
+}
@@ -0,0 +1,26 @@
+#include "Optimizers/RMSProp.h"
+#include "Optimizers/UpdateKernels.h"
+#include <stdexcept>
+
+RMSProp::RMSProp(double lr, double alpha, double epsilon, double momentum, double weight_decay,
+                 size_t batch_size, std::function<double(double, size_t)> scheduler)
+    : AdaptiveOptim(lr, batch_size, scheduler),
+      alpha(alpha), epsilon(epsilon), momentum(momentum), weight_decay(weight_decay) {
+    if (alpha < 0.0 || alpha >= 1.0) {
+        throw std::invalid_argument("RMSProp: alpha must be in [0, 1)");
+    }
+    if (epsilon <= 0.0) {
+        throw std::invalid_argument("RMSProp: epsilon must be positive");
+    }
+}
+
+void RMSProp::updateLayer(const ParameterGroup& group, Scalar* layer_state) {
+    Scalar* square_avg = layer_state;
+    Scalar* momentum_buffer = layer_state + group.count;
+
+    ParameterRegistry::update(group, [&](Scalar* params, Scalar* grads, size_t n, size_t offset) {
+        UpdateKernels::rmsprop(params, grads, square_avg + offset, momentum_buffer + offset, n,
+                               learning_rate, alpha, epsilon, momentum,
+                               weight_decay, clip_value_, grad_scale_);
+    });
+}
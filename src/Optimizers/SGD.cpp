@@ -1,5 +1,7 @@
 #include "Optimizers/SGD.h"
-#include "Layers/Layers.h"
+#include "Optimizers/UpdateKernels.h"
+#include "Optimizers/GradientClipping.h"
+#include "Utils/Atomics.h"
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
@@ -32,84 +34,90 @@ void SGD::decayLearningRate(double decay_factor) {
     if (!lr_scheduler) initial_lr = learning_rate;
 }
 
-void SGD::step(std::vector<BaseLayer*> layers, size_t batch_size) {
+void SGD::step(const ParameterRegistry& parameters, size_t batch_size) {
     if (batch_size == 0) {
         throw std::invalid_argument("Batch size must be positive");
     }
-    for (BaseLayer* layer : layers) {
-        updateLayer(layer, batch_size);
+    // Global-norm clipping: one reduction, factor folded into the update kernel
+    grad_scale_ = 1.0;
+    if (clip_norm_ > 0.0) {
+        last_grad_norm_ = GradientClipping::globalNorm(parameters);
+        grad_scale_ = GradientClipping::scaleFactor(last_grad_norm_, clip_norm_);
+    }
+    for (const ParameterGroup& group : parameters.getGroups()) {
+        updateLayer(group);
     }
 }
 
-void SGD::updateLayer(BaseLayer* layer, size_t batch_size) {
-    DenseLayer* dense_layer = dynamic_cast<DenseLayer*>(layer);
-    if (!dense_layer) return;
-
-    // Get references to parameters and gradients
-    const auto& weights = dense_layer->getWeights();
-    const auto& biases = dense_layer->getBiases();
-    auto& grad_weights = dense_layer->getGradWeights();
-    auto& grad_biases = dense_layer->getGradBiases();
-    
-    // Get matrix dimensions
-    const size_t output_size = weights.size();
-    const size_t input_size = weights.empty() ? 0 : weights[0].size();
-
-    // Initialize velocity buffers if using momentum
+void SGD::updateLayer(const ParameterGroup& group) {
+    // State is looked up once per layer, not per element
+    Scalar* state = nullptr;
     if (momentum > 0) {
-        if (velocity_weights.find(layer) == velocity_weights.end()) {
-            velocity_weights[layer] = std::vector<std::vector<double>>(
-                output_size, 
-                std::vector<double>(input_size, 0.0)  // Corrected: input_size columns
-            );
-            velocity_biases[layer] = std::vector<double>(biases.size(), 0.0);
+        auto& buffer = velocity[group.layer];
+        if (buffer.size() != group.count) {
+            buffer.assign(group.count, 0.0);
         }
+        state = buffer.data();
     }
 
     const double lr = this->learning_rate;
-    
-    // Create updated parameters
-    auto new_weights = weights;
-    auto new_biases = biases;
+    const double m = this->momentum;
+    const double clip = this->clip_value_;
+    const double scale = this->grad_scale_;
 
-    // Update weights
-    for (size_t i = 0; i < output_size; ++i) {
-        for (size_t j = 0; j < input_size; ++j) {
-            double g;
-            if (clip_value_ != 0.0)
-                g = std::clamp(grad_weights[i][j], -clip_value_, clip_value_);
-            else g = grad_weights[i][j];
-            if (momentum > 0) {
-                velocity_weights[layer][i][j] = 
-                    momentum * velocity_weights[layer][i][j] + 
-                    lr * g;
-                new_weights[i][j] -= velocity_weights[layer][i][j];
-            } else {
-                new_weights[i][j] -= lr * g;
-            }
-        }
+    // Clip, momentum, update and gradient zeroing in one in-place pass
+    ParameterRegistry::update(group, [&](Scalar* params, Scalar* grads, size_t n, size_t offset) {
+        UpdateKernels::sgd(params, grads, state ? state + offset : nullptr, n, lr, m, clip, scale);
+    });
+}
+
+size_t SGD::asyncBlockCount(const ParameterRegistry& registry) {
+    size_t blocks = 0;
+    for (const ParameterGroup& group : registry.getGroups()) {
+        for (const ParameterSpan& span : group.spans) blocks += (span.size + kAsyncBlock - 1) / kAsyncBlock;
+    }
+    return blocks;
+}
+
+void SGD::stepAsync(const ParameterRegistry& shared,
+                    const ParameterRegistry& worker,
+                    std::vector<std::vector<Scalar>>& velocity,
+                    uint32_t* block_versions) const {
+    if (shared.size() != worker.size() || shared.parameterCount() != worker.parameterCount()) {
+        throw std::invalid_argument("SGD::stepAsync: Shared and worker parameters differ");
+    }
+    double scale = 1.0;
+    if (clip_norm_ > 0.0) {
+        scale = GradientClipping::scaleFactor(GradientClipping::globalNorm(worker), clip_norm_);
     }
+    velocity.resize(shared.size());
 
-    // Update biases
-    for (size_t i = 0; i < new_biases.size(); ++i) {
-        double g;
-            if (clip_value_ != 0.0)
-                g = std::clamp(grad_biases[i], -clip_value_, clip_value_);
-            else g = grad_biases[i];
+    const double lr = this->learning_rate;
+    const double m = this->momentum;
+    const double clip = this->clip_value_;
+    size_t block = 0;
+    for (size_t g = 0; g < shared.size(); ++g) {
+        const ParameterGroup& target = shared.getGroups()[g];
+        const ParameterGroup& replica = worker.getGroups()[g];
+
+        Scalar* state = nullptr;
         if (momentum > 0) {
-            velocity_biases[layer][i] = 
-                momentum * velocity_biases[layer][i] + 
-                lr * g;
-            new_biases[i] -= velocity_biases[layer][i];
-        } else {
-            new_biases[i] -= lr * g;
+            if (velocity[g].size() != replica.count) {
+                velocity[g].assign(replica.count, 0.0);
+            }
+            state = velocity[g].data();
         }
-    }
 
-    // Update parameters via setters
-    dense_layer->setWeights(new_weights);
-    dense_layer->setBiases(new_biases);
-    
-    // Clear gradients after update
-    dense_layer->clearGradients();
+        // Shared values, worker gradients; runs on the calling thread (the workers are the parallelism)
+        for (size_t s = 0; s < replica.spans.size(); ++s) {
+            const ParameterSpan& span = replica.spans[s];
+            for (size_t lo = 0; lo < span.size; lo += kAsyncBlock, ++block) {
+                const size_t len = std::min(kAsyncBlock, span.size - lo);
+                const bool written = UpdateKernels::sgdHogwild(target.spans[s].values + lo, span.grads + lo,
+                                                               state ? state + span.offset + lo : nullptr,
+                                                               len, lr, m, clip, scale);
+                if (written && block_versions) Atomics::incrementRelease(block_versions + block);
+            }
+        }
+    }
 }
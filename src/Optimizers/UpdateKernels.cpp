@@ -0,0 +1,220 @@
+#include "Optimizers/UpdateKernels.h"
+#include "Utils/Atomics.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace UpdateKernels {
+
+namespace {
+
+inline Scalar clipBound(double clip) {
+    return clip != 0.0 ? static_cast<Scalar>(clip) : std::numeric_limits<Scalar>::infinity();
+}
+
+} // namespace
+
+void sgd(Scalar* params, Scalar* grads, Scalar* velocity, size_t n,
+         double lr, double momentum, double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar s_lr = static_cast<Scalar>(lr);
+    const Scalar s_momentum = static_cast<Scalar>(momentum);
+
+    if (momentum > 0.0) {
+        for (size_t i = 0; i < n; ++i) {
+            const Scalar g = std::min(std::max(scale * grads[i], lo), hi);
+            const Scalar v = s_momentum * velocity[i] + s_lr * g;
+            velocity[i] = v;
+            params[i] -= v;
+            grads[i] = Scalar(0);
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            const Scalar g = std::min(std::max(scale * grads[i], lo), hi);
+            params[i] -= s_lr * g;
+            grads[i] = Scalar(0);
+        }
+    }
+}
+
+bool sgdHogwild(Scalar* params, Scalar* grads, Scalar* velocity, size_t n,
+                double lr, double momentum, double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar s_lr = static_cast<Scalar>(lr);
+    const Scalar s_momentum = static_cast<Scalar>(momentum);
+    bool written = false;
+
+    // Zero steps are skipped: no load/store of shared memory, no lost update
+    if (momentum > 0.0) {
+        for (size_t i = 0; i < n; ++i) {
+            const Scalar g = std::min(std::max(scale * grads[i], lo), hi);
+            const Scalar v = s_momentum * velocity[i] + s_lr * g;
+            velocity[i] = v;
+            grads[i] = Scalar(0);
+            if (v == Scalar(0)) continue;
+            Atomics::storeRelaxed(params + i, Atomics::loadRelaxed(params + i) - v);
+            written = true;
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            const Scalar g = std::min(std::max(scale * grads[i], lo), hi);
+            grads[i] = Scalar(0);
+            if (g == Scalar(0)) continue;
+            Atomics::storeRelaxed(params + i, Atomics::loadRelaxed(params + i) - s_lr * g);
+            written = true;
+        }
+    }
+    return written;
+}
+
+void adam(Scalar* params, Scalar* grads, Scalar* m, Scalar* v, size_t n,
+          double lr, double beta1, double beta2, double eps,
+          double bias_correction1, double bias_correction2,
+          double weight_decay, bool decoupled, double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar b1 = static_cast<Scalar>(beta1);
+    const Scalar b2 = static_cast<Scalar>(beta2);
+    const Scalar one_minus_b1 = static_cast<Scalar>(1.0 - beta1);
+    const Scalar one_minus_b2 = static_cast<Scalar>(1.0 - beta2);
+    const Scalar step_size = static_cast<Scalar>(lr / bias_correction1);
+    const Scalar inv_sqrt_bc2 = static_cast<Scalar>(1.0 / std::sqrt(bias_correction2));
+    const Scalar s_eps = static_cast<Scalar>(eps);
+    // Decoupled decay scales p by (1 - lr wd); coupled decay adds wd p to g
+    const Scalar decay = static_cast<Scalar>(decoupled ? 1.0 - lr * weight_decay : 1.0);
+    const Scalar l2 = static_cast<Scalar>(decoupled ? 0.0 : weight_decay);
+
+    for (size_t i = 0; i < n; ++i) {
+        const Scalar p = params[i];
+        const Scalar g = std::min(std::max(scale * grads[i], lo), hi) + l2 * p;
+        const Scalar mi = b1 * m[i] + one_minus_b1 * g;
+        const Scalar vi = b2 * v[i] + one_minus_b2 * g * g;
+        m[i] = mi;
+        v[i] = vi;
+        params[i] = p * decay - step_size * mi / (std::sqrt(vi) * inv_sqrt_bc2 + s_eps);
+        grads[i] = Scalar(0);
+    }
+}
+
+void rmsprop(Scalar* params, Scalar* grads, Scalar* square_avg, Scalar* momentum_buffer, size_t n,
+             double lr, double alpha, double eps, double momentum,
+             double weight_decay, double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar a = static_cast<Scalar>(alpha);
+    const Scalar one_minus_a = static_cast<Scalar>(1.0 - alpha);
+    const Scalar s_lr = static_cast<Scalar>(lr);
+    const Scalar s_eps = static_cast<Scalar>(eps);
+    const Scalar s_momentum = static_cast<Scalar>(momentum);
+    const Scalar l2 = static_cast<Scalar>(weight_decay);
+
+    if (momentum > 0.0) {
+        for (size_t i = 0; i < n; ++i) {
+            const Scalar g = std::min(std::max(scale * grads[i], lo), hi) + l2 * params[i];
+            const Scalar s = a * square_avg[i] + one_minus_a * g * g;
+            const Scalar b = s_momentum * momentum_buffer[i] + g / (std::sqrt(s) + s_eps);
+            square_avg[i] = s;
+            momentum_buffer[i] = b;
+            params[i] -= s_lr * b;
+            grads[i] = Scalar(0);
+        }
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            const Scalar g = std::min(std::max(scale * grads[i], lo), hi) + l2 * params[i];
+            const Scalar s = a * square_avg[i] + one_minus_a * g * g;
+            square_avg[i] = s;
+            params[i] -= s_lr * g / (std::sqrt(s) + s_eps);
+            grads[i] = Scalar(0);
+        }
+    }
+}
+
+void adagrad(Scalar* params, Scalar* grads, Scalar* sum_sq, size_t n,
+             double lr, double eps, double weight_decay, double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar s_lr = static_cast<Scalar>(lr);
+    const Scalar s_eps = static_cast<Scalar>(eps);
+    const Scalar l2 = static_cast<Scalar>(weight_decay);
+
+    for (size_t i = 0; i < n; ++i) {
+        const Scalar g = std::min(std::max(scale * grads[i], lo), hi) + l2 * params[i];
+        const Scalar s = sum_sq[i] + g * g;
+        sum_sq[i] = s;
+        params[i] -= s_lr * g / (std::sqrt(s) + s_eps);
+        grads[i] = Scalar(0);
+    }
+}
+
+void lars(Scalar* params, Scalar* grads, Scalar* velocity, size_t n,
+          double local_lr, double momentum, double weight_decay,
+          double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar s_lr = static_cast<Scalar>(local_lr);
+    const Scalar s_momentum = static_cast<Scalar>(momentum);
+    const Scalar l2 = static_cast<Scalar>(weight_decay);
+
+    for (size_t i = 0; i < n; ++i) {
+        const Scalar g = std::min(std::max(scale * grads[i], lo), hi) + l2 * params[i];
+        const Scalar v = s_momentum * velocity[i] + s_lr * g;
+        velocity[i] = v;
+        params[i] -= v;
+        grads[i] = Scalar(0);
+    }
+}
+
+double lambMoments(const Scalar* params, Scalar* grads, Scalar* m, Scalar* v, size_t n,
+                   double beta1, double beta2, double eps,
+                   double bias_correction1, double bias_correction2,
+                   double weight_decay, double clip, double grad_scale) {
+    const Scalar hi = clipBound(clip);
+    const Scalar lo = -hi;
+    const Scalar scale = static_cast<Scalar>(grad_scale);
+    const Scalar b1 = static_cast<Scalar>(beta1);
+    const Scalar b2 = static_cast<Scalar>(beta2);
+    const Scalar one_minus_b1 = static_cast<Scalar>(1.0 - beta1);
+    const Scalar one_minus_b2 = static_cast<Scalar>(1.0 - beta2);
+    const Scalar inv_bc1 = static_cast<Scalar>(1.0 / bias_correction1);
+    const Scalar inv_sqrt_bc2 = static_cast<Scalar>(1.0 / std::sqrt(bias_correction2));
+    const Scalar s_eps = static_cast<Scalar>(eps);
+    const Scalar wd = static_cast<Scalar>(weight_decay);
+
+    double update_sq = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const Scalar g = std::min(std::max(scale * grads[i], lo), hi);
+        const Scalar mi = b1 * m[i] + one_minus_b1 * g;
+        const Scalar vi = b2 * v[i] + one_minus_b2 * g * g;
+        m[i] = mi;
+        v[i] = vi;
+        grads[i] = Scalar(0);
+        const Scalar u = mi * inv_bc1 / (std::sqrt(vi) * inv_sqrt_bc2 + s_eps) + wd * params[i];
+        update_sq += static_cast<double>(u) * u;
+    }
+    return update_sq;
+}
+
+void lambApply(Scalar* params, const Scalar* m, const Scalar* v, size_t n,
+               double step, double eps, double bias_correction1, double bias_correction2,
+               double weight_decay) {
+    const Scalar inv_bc1 = static_cast<Scalar>(1.0 / bias_correction1);
+    const Scalar inv_sqrt_bc2 = static_cast<Scalar>(1.0 / std::sqrt(bias_correction2));
+    const Scalar s_eps = static_cast<Scalar>(eps);
+    const Scalar wd = static_cast<Scalar>(weight_decay);
+    const Scalar s_step = static_cast<Scalar>(step);
+
+    for (size_t i = 0; i < n; ++i) {
+        const Scalar u = m[i] * inv_bc1 / (std::sqrt(v[i]) * inv_sqrt_bc2 + s_eps) + wd * params[i];
+        params[i] -= s_step * u;
+    }
+}
+
+} // namespace UpdateKernels
@@ -1,4 +1,6 @@
 #include "Utils/Activations.h"
+#include "Utils/FastMath.h"
+#include "Utils/ThreadPool.h"
 #include <cmath>
 #include <algorithm>
 #include <stdexcept>
@@ -6,140 +8,202 @@
 namespace Activations {
 
 // Scalar implementations
-double sigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
-double relu(double x) { return (x > 0) ? x : 0; }
-double tanh(double x) { return std::tanh(x); }
-double softplus(double x) { return std::log(1 + std::exp(x)); }
+Scalar sigmoid(Scalar x) { return FastMath::sigmoid(x); }
+Scalar relu(Scalar x) { return (x > 0) ? x : 0; }
+Scalar tanh(Scalar x) { return FastMath::tanh(x); }
+Scalar softplus(Scalar x) { return FastMath::log(1 + FastMath::exp(x)); }
 
 // Vector implementations
-std::vector<double> sigmoid(const std::vector<double>& x) {
-    std::vector<double> result;
-    result.reserve(x.size());
-    for (double val : x) result.push_back(sigmoid(val));
+std::vector<Scalar> sigmoid(const std::vector<Scalar>& x) {
+    std::vector<Scalar> result(x.size());
+    FastMath::sigmoid(x.data(), result.data(), x.size());
     return result;
 }
 
-std::vector<double> relu(const std::vector<double>& x) {
-    std::vector<double> result;
+std::vector<Scalar> relu(const std::vector<Scalar>& x) {
+    std::vector<Scalar> result;
     result.reserve(x.size());
-    for (double val : x) result.push_back(relu(val));
+    for (Scalar val : x) result.push_back(relu(val));
     return result;
 }
 
-std::vector<double> tanh(const std::vector<double>& x) {
-    std::vector<double> result;
-    result.reserve(x.size());
-    for (double val : x) result.push_back(tanh(val));
+std::vector<Scalar> tanh(const std::vector<Scalar>& x) {
+    std::vector<Scalar> result(x.size());
+    FastMath::tanh(x.data(), result.data(), x.size());
     return result;
 }
 
-std::vector<double> softmax(const std::vector<double>& x) {
+std::vector<Scalar> softmax(const std::vector<Scalar>& x) {
     if (x.empty()) throw std::invalid_argument("softmax: Input vector cannot be empty");
     
-    double max_elem = *std::max_element(x.begin(), x.end());
+    Scalar max_elem = *std::max_element(x.begin(), x.end());
+    std::vector<Scalar> result(x.size());
+    for (size_t i = 0; i < x.size(); ++i) result[i] = x[i] - max_elem;
+    FastMath::exp(result.data(), result.data(), result.size());
+
     double sum = 0.0;
-    std::vector<double> exp_vals;
-    exp_vals.reserve(x.size());
-    
-    for (double val : x) {
-        double exp_val = std::exp(val - max_elem);
-        exp_vals.push_back(exp_val);
-        sum += exp_val;
-    }
+    for (Scalar ev : result) sum += ev;
     
-    if (sum < 1e-15) return std::vector<double>(x.size(), 1.0/x.size());
+    if (sum < 1e-15) return std::vector<Scalar>(x.size(), 1.0/x.size());
     
-    std::vector<double> result;
-    result.reserve(x.size());
-    for (double ev : exp_vals) result.push_back(ev / sum);
+    for (Scalar& ev : result) ev /= sum;
     return result;
 }
 
 // Batch implementations
-std::vector<std::vector<double>> sigmoid_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> sigmoid_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(sigmoid(vec));
     return result;
 }
 
-std::vector<std::vector<double>> relu_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> relu_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(relu(vec));
     return result;
 }
 
-std::vector<std::vector<double>> tanh_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> tanh_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(tanh(vec));
     return result;
 }
 
-std::vector<std::vector<double>> softmax_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> softmax_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(softmax(vec));
     return result;
 }
 
 // Derivative implementations
-double sigmoid_derivative(double x) {
-    double s = sigmoid(x);
+Scalar sigmoid_derivative(Scalar x) {
+    Scalar s = sigmoid(x);
     return s * (1 - s);
 }
 
-double relu_derivative(double x) {
+Scalar relu_derivative(Scalar x) {
     return (x > 0) ? 1 : 0;
 }
 
-double tanh_derivative(double x) {
-    double t = tanh(x);
+Scalar tanh_derivative(Scalar x) {
+    Scalar t = tanh(x);
     return 1 - t*t;
 }
 
-std::vector<double> sigmoid_derivative(const std::vector<double>& x) {
-    std::vector<double> result;
+std::vector<Scalar> sigmoid_derivative(const std::vector<Scalar>& x) {
+    std::vector<Scalar> result;
     result.reserve(x.size());
-    for (double val : x) result.push_back(sigmoid_derivative(val));
+    for (Scalar val : x) result.push_back(sigmoid_derivative(val));
     return result;
 }
 
-std::vector<double> relu_derivative(const std::vector<double>& x) {
-    std::vector<double> result;
+std::vector<Scalar> relu_derivative(const std::vector<Scalar>& x) {
+    std::vector<Scalar> result;
     result.reserve(x.size());
-    for (double val : x) result.push_back(relu_derivative(val));
+    for (Scalar val : x) result.push_back(relu_derivative(val));
     return result;
 }
 
-std::vector<double> tanh_derivative(const std::vector<double>& x) {
-    std::vector<double> result;
+std::vector<Scalar> tanh_derivative(const std::vector<Scalar>& x) {
+    std::vector<Scalar> result;
     result.reserve(x.size());
-    for (double val : x) result.push_back(tanh_derivative(val));
+    for (Scalar val : x) result.push_back(tanh_derivative(val));
     return result;
 }
 
 // Batch derivatives
-std::vector<std::vector<double>> sigmoid_derivative_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> sigmoid_derivative_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(sigmoid_derivative(vec));
     return result;
 }
 
-std::vector<std::vector<double>> relu_derivative_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> relu_derivative_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(relu_derivative(vec));
     return result;
 }
 
-std::vector<std::vector<double>> tanh_derivative_batch(const std::vector<std::vector<double>>& x) {
-    std::vector<std::vector<double>> result;
+std::vector<std::vector<Scalar>> tanh_derivative_batch(const std::vector<std::vector<Scalar>>& x) {
+    std::vector<std::vector<Scalar>> result;
     result.reserve(x.size());
     for (const auto& vec : x) result.push_back(tanh_derivative(vec));
     return result;
 }
 
+// In-place contiguous batch kernels
+namespace {
+
+// Rows per task so that each chunk touches at least ~16K elements
+size_t rowGrain(const MatrixView& x) {
+    return std::max<size_t>(1, 16384 / std::max<size_t>(1, x.cols));
+}
+
+template <typename RowFn>
+void forEachRow(MatrixView x, RowFn row_fn) {
+    ThreadPool::global().parallelFor(0, x.rows, [&](size_t lo, size_t hi) {
+        for (size_t r = lo; r < hi; ++r) row_fn(x.row(r), x.cols);
+    }, rowGrain(x));
+}
+
+} // namespace
+
+void sigmoid_batch(MatrixView x) {
+    forEachRow(x, [](Scalar* row, size_t n) { FastMath::sigmoid(row, row, n); });
+}
+
+void relu_batch(MatrixView x) {
+    forEachRow(x, [](Scalar* row, size_t n) {
+        for (size_t j = 0; j < n; ++j) row[j] = std::max(Scalar(0), row[j]);
+    });
+}
+
+void tanh_batch(MatrixView x) {
+    forEachRow(x, [](Scalar* row, size_t n) { FastMath::tanh(row, row, n); });
+}
+
+void softmax_batch(MatrixView x) {
+    if (x.cols == 0) throw std::invalid_argument("softmax_batch: Rows cannot be empty");
+    forEachRow(x, [](Scalar* row, size_t n) {
+        const Scalar max_elem = *std::max_element(row, row + n);
+        for (size_t j = 0; j < n; ++j) row[j] -= max_elem;
+        FastMath::exp(row, row, n);
+
+        double sum = 0.0;
+        for (size_t j = 0; j < n; ++j) sum += row[j];
+        if (sum < 1e-15) {
+            std::fill(row, row + n, static_cast<Scalar>(1.0 / n));
+            return;
+        }
+        const Scalar inv_sum = static_cast<Scalar>(1.0 / sum);
+        for (size_t j = 0; j < n; ++j) row[j] *= inv_sum;
+    });
+}
+
+void sigmoid_derivative_batch(MatrixView x) {
+    forEachRow(x, [](Scalar* row, size_t n) {
+        FastMath::sigmoid(row, row, n);
+        for (size_t j = 0; j < n; ++j) row[j] = row[j] * (1 - row[j]);
+    });
+}
+
+void relu_derivative_batch(MatrixView x) {
+    forEachRow(x, [](Scalar* row, size_t n) {
+        for (size_t j = 0; j < n; ++j) row[j] = (row[j] > 0) ? Scalar(1) : Scalar(0);
+    });
+}
+
+void tanh_derivative_batch(MatrixView x) {
+    forEachRow(x, [](Scalar* row, size_t n) {
+        FastMath::tanh(row, row, n);
+        for (size_t j = 0; j < n; ++j) row[j] = 1 - row[j] * row[j];
+    });
+}
+
 } // namespace Activations
@@ -0,0 +1,45 @@
+#include "Utils/FastMath.h"
+
+namespace FastMath {
+
+void exp(const Scalar* x, Scalar* y, size_t n) {
+    if (isFast()) {
+        for (size_t i = 0; i < n; ++i) y[i] = expApprox(x[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) y[i] = std::exp(x[i]);
+    }
+}
+
+void log(const Scalar* x, Scalar* y, size_t n) {
+    if (isFast()) {
+        for (size_t i = 0; i < n; ++i) y[i] = logApprox(x[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) y[i] = std::log(x[i]);
+    }
+}
+
+void tanh(const Scalar* x, Scalar* y, size_t n) {
+    if (isFast()) {
+        for (size_t i = 0; i < n; ++i) y[i] = tanhApprox(x[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) y[i] = std::tanh(x[i]);
+    }
+}
+
+void sigmoid(const Scalar* x, Scalar* y, size_t n) {
+    if (isFast()) {
+        for (size_t i = 0; i < n; ++i) y[i] = sigmoidApprox(x[i]);
+    } else {
+        for (size_t i = 0; i < n; ++i) y[i] = Scalar(1) / (Scalar(1) + std::exp(-x[i]));
+    }
+}
+
+const char* toString(MathAccuracy mode) {
+    switch (mode) {
+        case MathAccuracy::PRECISE: return "precise";
+        case MathAccuracy::FAST: return "fast";
+        default: return "unknown";
+    }
+}
+
+} // namespace FastMath
@@ -0,0 +1,41 @@
+#include "Utils/HalfPrecision.h"
+#include <stdexcept>
+
+namespace HalfPrecision {
+
+void encode(const Scalar* src, uint16_t* dst, size_t n, StoragePrecision precision) {
+    switch (precision) {
+        case StoragePrecision::BF16:
+            for (size_t i = 0; i < n; ++i) dst[i] = floatToBF16(static_cast<float>(src[i]));
+            break;
+        case StoragePrecision::FP16:
+            for (size_t i = 0; i < n; ++i) dst[i] = floatToFP16(static_cast<float>(src[i]));
+            break;
+        default:
+            throw std::invalid_argument("HalfPrecision::encode: NATIVE is not a 16-bit format");
+    }
+}
+
+void decode(const uint16_t* src, Scalar* dst, size_t n, StoragePrecision precision) {
+    switch (precision) {
+        case StoragePrecision::BF16:
+            for (size_t i = 0; i < n; ++i) dst[i] = static_cast<Scalar>(bf16ToFloat(src[i]));
+            break;
+        case StoragePrecision::FP16:
+            for (size_t i = 0; i < n; ++i) dst[i] = static_cast<Scalar>(fp16ToFloat(src[i]));
+            break;
+        default:
+            throw std::invalid_argument("HalfPrecision::decode: NATIVE is not a 16-bit format");
+    }
+}
+
+const char* toString(StoragePrecision precision) {
+    switch (precision) {
+        case StoragePrecision::NATIVE: return "native";
+        case StoragePrecision::BF16: return "bf16";
+        case StoragePrecision::FP16: return "fp16";
+        default: return "unknown";
+    }
+}
+
+} // namespace HalfPrecision
@@ -10,7 +10,7 @@ double clamp(double val, double lo, double hi) {
     return (val < lo) ? lo : (hi < val) ? hi : val;
 }
 
-std::vector<std::vector<double>> initializeParameters(
+std::vector<std::vector<Scalar>> initializeParameters(
     size_t in_features,
     size_t out_features,
     InitMethod method,
@@ -25,7 +25,7 @@ std::vector<std::vector<double>> initializeParameters(
     }
     sparsity = clamp(sparsity, 0.0, 1.0);
 
-    std::vector<std::vector<double>> parameters(out_features, std::vector<double>(in_features));
+    std::vector<std::vector<Scalar>> parameters(out_features, std::vector<Scalar>(in_features));
     std::mt19937 rng(seed);
     std::uniform_real_distribution<double> uni_dist(0.0, 1.0); // For sparsity
     std::uniform_real_distribution<double> sparsity_dist(0.0, 1.0);
@@ -0,0 +1,24 @@
+#include "Utils/Reduction.h"
+
+namespace Reduction {
+
+double pairwise(const double* values, size_t n) {
+    if (n == 0) return 0.0;
+    if (n == 1) return values[0];
+    if (n == 2) return values[0] + values[1];
+    const size_t half = n / 2;
+    return pairwise(values, half) + pairwise(values + half, n - half);
+}
+
+double sum(const Scalar* x, size_t n) {
+    return sum(n, [x](size_t i) { return static_cast<double>(x[i]); });
+}
+
+double sumSquares(const Scalar* x, size_t n) {
+    return sum(n, [x](size_t i) {
+        const double v = x[i];
+        return v * v;
+    });
+}
+
+} // namespace Reduction
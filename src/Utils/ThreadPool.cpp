@@ -0,0 +1,124 @@
+#include "Utils/ThreadPool.h"
+#include <algorithm>
+
+namespace {
+
+thread_local bool in_pool_task = false;  // nested parallelFor runs inline
+
+std::mutex global_mutex;                       // guards creation / replacement only
+std::unique_ptr<ThreadPool> global_pool;
+std::atomic<ThreadPool*> global_instance{nullptr};  // lock-free read path of global()
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    work_cv.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::workerLoop() {
+    size_t seen_generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work_cv.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) return;
+            seen_generation = generation;
+            ++active_workers;
+        }
+        runChunks();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --active_workers;
+        }
+        done_cv.notify_all();
+    }
+}
+
+void ThreadPool::runChunks() {
+    const bool was_in_task = in_pool_task;
+    in_pool_task = true;
+    for (;;) {
+        const size_t c = job.next_chunk.fetch_add(1, std::memory_order_relaxed);
+        if (c >= job.num_chunks) break;
+        const size_t lo = job.begin + c * job.chunk;
+        const size_t hi = std::min(lo + job.chunk, job.end);
+        try {
+            job.invoke(job.ctx, lo, hi);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!job.error) job.error = std::current_exception();
+        }
+    }
+    in_pool_task = was_in_task;
+}
+
+void ThreadPool::run(void (*invoke)(void*, size_t, size_t), void* ctx, size_t begin, size_t end, size_t grain) {
+    const size_t n = end - begin;
+    grain = std::max<size_t>(grain, 1);
+    if (workers.empty() || in_pool_task || n <= grain) {
+        invoke(ctx, begin, end);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex);
+
+    // About four chunks per thread for load balance, never smaller than the grain
+    const size_t target_chunks = 4 * size();
+    const size_t chunk = std::max(grain, (n + target_chunks - 1) / target_chunks);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&] { return active_workers == 0; });  // stragglers from the previous job
+        job.invoke = invoke;
+        job.ctx = ctx;
+        job.begin = begin;
+        job.end = end;
+        job.chunk = chunk;
+        job.num_chunks = (n + chunk - 1) / chunk;
+        job.next_chunk.store(0, std::memory_order_relaxed);
+        job.error = nullptr;
+        ++generation;
+    }
+    work_cv.notify_all();
+
+    runChunks();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&] { return active_workers == 0; });
+        error = job.error;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+ThreadPool& ThreadPool::global() {
+    if (ThreadPool* pool = global_instance.load(std::memory_order_acquire)) return *pool;
+    std::lock_guard<std::mutex> lock(global_mutex);
+    if (!global_pool) {
+        global_pool = std::make_unique<ThreadPool>();
+        global_instance.store(global_pool.get(), std::memory_order_release);
+    }
+    return *global_pool;
+}
+
+void ThreadPool::setGlobalThreads(size_t num_threads) {
+    std::lock_guard<std::mutex> lock(global_mutex);
+    auto pool = std::make_unique<ThreadPool>(num_threads);
+    global_instance.store(pool.get(), std::memory_order_release);
+    global_pool = std::move(pool);
+}
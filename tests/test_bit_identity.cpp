@@ -0,0 +1,159 @@
+// Checks the documented bit-identity guarantees of Sequential: training with
+// micro-batches, checkpoints, fused layers, flat buffers or a compiled plan
+// gives exactly the weights of plain training, and the inference paths agree
+// with forward() bit for bit.
+// Run with: make test
+#include <iostream>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+#include "Models/Sequential.h"
+#include "Metrics/LossFunctions.h"
+#include "Optimizers/SGD.h"
+#include "Optimizers/Adam.h"
+#include "Utils/ThreadPool.h"
+
+static int failures = 0;
+
+static void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+static bool sameBits(const std::vector<Scalar>& a, const std::vector<Scalar>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Scalar)) == 0;
+}
+
+static bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static Sequential makeModel() {
+    Sequential model(
+        std::make_unique<DenseLayer>(8, 16),
+        std::make_unique<ActivationLayer>(ActivationType::RELU),
+        std::make_unique<DenseLayer>(16, 16),
+        std::make_unique<ActivationLayer>(ActivationType::TANH),
+        std::make_unique<DenseLayer>(16, 12),
+        std::make_unique<ActivationLayer>(ActivationType::LEAKY_RELU),
+        std::make_unique<DenseLayer>(12, 3));
+    model.initializeParameters(11);
+    return model;
+}
+
+// All trainable values in registry order
+static std::vector<Scalar> parametersOf(Sequential& model) {
+    std::vector<Scalar> values;
+    for (const ParameterGroup& group : model.getParameters().getGroups()) {
+        for (const ParameterSpan& span : group.spans) {
+            values.insert(values.end(), span.values, span.values + span.size);
+        }
+    }
+    return values;
+}
+
+struct Result {
+    std::vector<Scalar> parameters;
+    double loss = 0.0;
+};
+
+// Two epochs of SGD with momentum and one of Adam, after an optional setup step
+static Result trainWith(const Dataset& X, const Dataset& y, const std::function<void(Sequential&)>& setup) {
+    Sequential model = makeModel();
+    setup(model);
+    const Losses::CrossEntropyLoss loss(true);
+    SGD sgd(0.05, 0.9, 32);
+    Adam adam(0.01, 0.9, 0.999, 1e-8, 0.0, 32);
+    Result result;
+    result.loss = model.train(X, y, sgd, loss, 7);
+    result.loss += model.train(X, y, sgd, loss, 8);
+    result.loss += model.train(X, y, adam, loss, 9);
+    result.parameters = parametersOf(model);
+    return result;
+}
+
+int main() {
+    ThreadPool::setGlobalThreads(4);
+
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<std::vector<Scalar>> rows, targets;
+    for (int i = 0; i < 200; ++i) {
+        std::vector<Scalar> x(8);
+        for (auto& v : x) v = static_cast<Scalar>(noise(rng));
+        std::vector<Scalar> t(3, 0.0);
+        t[(x[0] > 0) + (x[1] > 0.5)] = 1.0;
+        rows.push_back(x);
+        targets.push_back(t);
+    }
+    const Dataset X(rows), y(targets);
+
+    // Training variants against plain training
+    const Result plain = trainWith(X, y, [](Sequential&) {});
+    const std::vector<std::pair<std::string, std::function<void(Sequential&)>>> variants = {
+        {"micro-batches of 5", [](Sequential& m) { m.setMicroBatchSize(5); }},
+        {"checkpoints {2, 4}", [](Sequential& m) { m.setCheckpoints({2, 4}); }},
+        {"checkpoint every layer", [](Sequential& m) { m.setCheckpoints({1, 2, 3, 4, 5, 6}); }},
+        {"fused layers", [](Sequential& m) { m.fuseLayers(); }},
+        {"fused layers + checkpoints", [](Sequential& m) { m.fuseLayers(); m.setCheckpoints({1, 2}); }},
+        {"flat parameters", [](Sequential& m) { m.flattenParameters(); }},
+        {"compiled plan", [](Sequential& m) { m.compile(8); }},
+        {"micro-batches + checkpoints + flat",
+         [](Sequential& m) { m.setMicroBatchSize(7); m.setCheckpoints({3}); m.flattenParameters(); }},
+    };
+    for (const auto& [name, setup] : variants) {
+        const Result r = trainWith(X, y, setup);
+        check(sameBits(r.parameters, plain.parameters), name + ": weights bit-identical to plain training");
+        check(sameBits(r.loss, plain.loss), name + ": loss bit-identical to plain training");
+    }
+
+    // Checkpointing with replicas and with 16-bit storage, against the same setup without it
+    const Result replicas = trainWith(X, y, [](Sequential& m) { m.setDataParallel(3); });
+    const Result replicas_ckpt = trainWith(X, y, [](Sequential& m) { m.setDataParallel(3); m.setCheckpoints({2, 5}); });
+    check(sameBits(replicas_ckpt.parameters, replicas.parameters), "checkpoints with 3 replicas: weights bit-identical");
+    const Result bf16 = trainWith(X, y, [](Sequential& m) { m.setStoragePrecision(StoragePrecision::BF16); });
+    const Result bf16_ckpt = trainWith(X, y, [](Sequential& m) {
+        m.setStoragePrecision(StoragePrecision::BF16);
+        m.setCheckpoints({2, 4});
+    });
+    check(sameBits(bf16_ckpt.parameters, bf16.parameters), "checkpoints with BF16 storage: weights bit-identical");
+
+    // Inference paths against forward()
+    Sequential model = makeModel();
+    const Dataset batch = model.predict(X);
+    std::vector<Scalar> scratch, into(3);
+    bool batch_ok = true, into_ok = true, single_ok = true;
+    for (size_t i = 0; i < X.rows(); ++i) {
+        const std::vector<Scalar> reference = model.forward(X[i]);
+        batch_ok = batch_ok && sameBits(batch[i], reference);
+        model.predictInto(X[i].data(), X.cols(), into.data(), scratch);
+        into_ok = into_ok && sameBits(into, reference);
+        single_ok = single_ok && sameBits(model.predict(X[i]), reference);
+    }
+    check(batch_ok, "predict(Dataset) matches forward()");
+    check(into_ok, "predictInto matches forward()");
+    check(single_ok, "predict(vector) matches forward()");
+
+    model.compile(8);
+    bool compiled_ok = true;
+    for (size_t i = 0; i < X.rows(); ++i) {
+        const ConstMatrixView out = model.forwardCompiled(X[i]);
+        const std::vector<Scalar> compiled(out.data, out.data + out.cols);
+        compiled_ok = compiled_ok && sameBits(compiled, model.predict(X[i]));
+    }
+    check(compiled_ok, "forwardCompiled matches predict()");
+
+    // evaluate() does not depend on the thread count
+    const Losses::CrossEntropyLoss loss(true);
+    const Sequential::Evaluation threaded = model.evaluate(X, y, loss);
+    ThreadPool::setGlobalThreads(1);
+    const Sequential::Evaluation serial = model.evaluate(X, y, loss);
+    check(sameBits(threaded.loss, serial.loss), "evaluate loss is the same on 1 and 4 threads");
+    check(threaded.predictions == serial.predictions, "evaluate predictions are the same on 1 and 4 threads");
+
+    if (failures == 0) std::cout << "test_bit_identity: all checks passed\n";
+    return failures == 0 ? 0 : 1;
+}
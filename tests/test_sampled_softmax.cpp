@@ -0,0 +1,104 @@
+// Checks for the sampled softmax loss and its candidate samplers.
+// Run with: make test
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+#include <random>
+#include "Metrics/SampledSoftmax.h"
+#include "Models/Sequential.h"
+
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << "\n";
+        ++failures;
+    }
+}
+
+int main() {
+    // Zero counts are rejected: Q(c) = 0 would make the logit correction infinite
+    bool threw = false;
+    try {
+        Losses::CandidateSampler sampler({5.0, 0.0, 3.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "unigram sampler rejects a zero count");
+
+    threw = false;
+    try {
+        Losses::CandidateSampler sampler({5.0, -1.0, 3.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "unigram sampler rejects a negative count");
+
+    // Rare (small-count) true class: loss and gradient stay finite
+    Losses::CandidateSampler sampler({1000.0, 1e-12, 10.0, 1.0}, 0.75, 7);
+    const std::vector<size_t> candidates = {1, 0, 2, 3, 0};
+    const std::vector<Scalar> logits = {0.5, -1.0, 2.0, 0.25, -1.0};
+    std::vector<Scalar> grad(logits.size());
+    std::vector<double> corrected;
+    const double loss = Losses::sampled_softmax_loss(logits.data(), candidates.data(), candidates.size(),
+                                                     sampler, grad.data(), corrected);
+    check(std::isfinite(loss), "loss is finite for a rare true class");
+    bool grad_finite = true;
+    double grad_sum = 0.0;
+    for (Scalar g : grad) {
+        grad_finite = grad_finite && std::isfinite(g);
+        grad_sum += g;
+    }
+    check(grad_finite, "gradient is finite for a rare true class");
+    check(std::abs(grad_sum) < 1e-6, "softmax gradient sums to zero");
+
+    // The buffer overload matches the allocating one, also with grad aliasing logits
+    std::vector<Scalar> aliased = logits;
+    const double loss_alias = Losses::sampled_softmax_loss(aliased.data(), candidates.data(), candidates.size(),
+                                                           sampler, aliased.data());
+    check(loss_alias == loss, "both overloads give the same loss");
+    check(aliased == grad, "gradient may alias the logits");
+
+    // trainSampled steps only the touched output rows: a class that is never
+    // a label and (practically) never sampled keeps its weights bit for bit,
+    // and the 16-bit copies of the rows it did step match a full re-encode
+    const size_t classes = 40, features = 6;
+    std::vector<double> counts(classes, 1.0);
+    counts[classes - 1] = 1e-30;
+    std::mt19937 rng(5);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<std::vector<Scalar>> rows;
+    std::vector<size_t> labels;
+    for (size_t i = 0; i < 96; ++i) {
+        std::vector<Scalar> x(features);
+        for (auto& v : x) v = static_cast<Scalar>(noise(rng));
+        rows.push_back(x);
+        labels.push_back(i % (classes - 1));
+    }
+    const Dataset X(rows);
+    Sequential model(std::make_unique<DenseLayer>(features, 8),
+                     std::make_unique<ActivationLayer>(ActivationType::RELU),
+                     std::make_unique<DenseLayer>(8, classes));
+    model.initializeParameters(3);
+    model.setStoragePrecision(StoragePrecision::BF16);
+    const Scalar* last_row = model.getParameters().getGroups().back().spans.front().values + 8 * (classes - 1);
+    const std::vector<Scalar> initial(last_row, last_row + 8);
+    Losses::CandidateSampler rare_last(counts, 1.0, 9);
+    SGD sgd(0.05, 0.9, 16);
+    model.trainSampled(X, labels, sgd, rare_last, 8, 4);
+    model.trainSampled(X, labels, sgd, rare_last, 8, 5);
+    check(std::memcmp(initial.data(), last_row, initial.size() * sizeof(Scalar)) == 0,
+          "untouched output row keeps its weights");
+
+    const std::vector<Scalar> sparse = model.forward(X[0]);
+    model.setStoragePrecision(StoragePrecision::BF16);     // re-encodes every row
+    const std::vector<Scalar> reencoded = model.forward(X[0]);
+    check(sparse.size() == reencoded.size() &&
+          std::memcmp(sparse.data(), reencoded.data(), sparse.size() * sizeof(Scalar)) == 0,
+          "sparse step keeps the 16-bit weights in sync");
+
+    if (failures == 0) std::cout << "test_sampled_softmax: all checks passed\n";
+    return failures == 0 ? 0 : 1;
+}